@@ -73,6 +73,14 @@ int main(void)
   setvbuf(stdout, NULL, _IONBF, 0);
   setvbuf(stderr, NULL, _IONBF, 0);
 
+  // vectors of the merge test live in the arena, which is reset after each test
+  Vector_Arena_t *arena = Vector_ArenaCreate(0);
+  if (arena == NULL) {
+    printf("Memory for arena was not allocated successfully.\n");
+    Vector_Destroy(&vector);
+    return 0;
+  }
+
   while (run) {
     printf("Press:\n"
            "1 to show the length of vector\n"
@@ -113,20 +121,12 @@ int main(void)
         Vector_Remove(vector, n);
         break;
 
-      case '4':
-        if (Vector_Length(vector) != SIZE_MAX) {
-          for (size_t i = 0; i < Vector_Length(vector); i++) {
-            Vector_DataType_t elm;
-
-            if (Vector_At(vector, i, &elm)) {
-              printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, elm);
-            } else {
-              printf("Item at position %zu was not found within the vector.\n", i);
-            }
-          }
+      case '4': {
+        Vector_Span_t span = Vector_GetSpan(vector);
+        for (size_t i = 0; i < span.length; i++) {
+          printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, span.data[i]);
         }
-
-        break;
+      } break;
 
       case '5':
         printf("Choose the value of an item to be found:\n");
@@ -175,16 +175,9 @@ int main(void)
         Vector_t *copy = Vector_Copy(vector);
 
         if (copy != NULL) {
-          if (Vector_Length(copy) != SIZE_MAX) {
-            for (size_t i = 0; i < Vector_Length(copy); i++) {
-              Vector_DataType_t elm;
-
-              if (Vector_At(copy, i, &elm)) {
-                printf("copy[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, elm);
-              } else {
-                printf("Item at position %zu was not found within the vector.\n", i);
-              }
-            }
+          Vector_Span_t span = Vector_GetSpan(copy);
+          for (size_t i = 0; i < span.length; i++) {
+            printf("copy[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, span.data[i]);
           }
 
           printf("Removing the vector \"copy\"\n");
@@ -231,7 +224,7 @@ int main(void)
         GET_VECTOR_VALUE_AND_TEST(multi1);
 
         Vector_t *vector1;
-        vector1 = Vector_Create(size1, incr1);
+        vector1 = Vector_CreateInArena(arena, size1, incr1);
         for (Vector_DataType_t val = 0; val < 100; val += multi1)
         {
           Vector_Append(vector1, val);
@@ -250,59 +243,36 @@ int main(void)
         GET_VECTOR_VALUE_AND_TEST(multi2);
 
         Vector_t *vector2;
-        vector2 = Vector_Create(size2, incr2);
+        vector2 = Vector_CreateInArena(arena, size2, incr2);
         for (Vector_DataType_t val = 0; val < 100; val += multi2)
         {
           Vector_Append(vector2, val);
         }
 
         Vector_t * vector3;
-        vector3 = Vector_Create(size1 + size2, incr1);
+        vector3 = Vector_CreateInArena(arena, size1 + size2, incr1);
 
         printf("Contents of vector1:");
-        if (Vector_Length(vector1) != SIZE_MAX) {
-          for (size_t i = 0; i < Vector_Length(vector1); i++) {
-            Vector_DataType_t elm;
-
-            if (Vector_At(vector1, i, &elm)) {
-              printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, elm);
-            } else {
-              printf("Item at position %zu was not found within the vector.\n", i);
-            }
-          }
+        Vector_Span_t span1 = Vector_GetSpan(vector1);
+        for (size_t i = 0; i < span1.length; i++) {
+          printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, span1.data[i]);
         }
 
         printf("Contents of vector2:");
-        if (Vector_Length(vector2) != SIZE_MAX) {
-          for (size_t i = 0; i < Vector_Length(vector2); i++) {
-            Vector_DataType_t elm;
-
-            if (Vector_At(vector2, i, &elm)) {
-              printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, elm);
-            } else {
-              printf("Item at position %zu was not found within the vector.\n", i);
-            }
-          }
+        Vector_Span_t span2 = Vector_GetSpan(vector2);
+        for (size_t i = 0; i < span2.length; i++) {
+          printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, span2.data[i]);
         }
 
         printf("Starting the merge of vector1 and vector2.");
         Merge(vector3, vector1, vector2);
 
-        if (Vector_Length(vector3) != SIZE_MAX) {
-          for (size_t i = 0; i < Vector_Length(vector3); i++) {
-            Vector_DataType_t elm;
-
-            if (Vector_At(vector3, i, &elm)) {
-              printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, elm);
-            } else {
-              printf("Item at position %zu was not found within the vector.\n", i);
-            }
-          }
+        Vector_Span_t merged = Vector_GetSpan(vector3);
+        for (size_t i = 0; i < merged.length; i++) {
+          printf("vector[%zu]: %" VECTOR_DATATYPE_PRINT "\n", i, merged.data[i]);
         }
 
-        Vector_Destroy(&vector1);
-        Vector_Destroy(&vector2);
-        Vector_Destroy(&vector3);
+        Vector_ArenaReset(arena);
 
       } break;
 
@@ -315,6 +285,7 @@ int main(void)
   printf("Freeing all allocated memory.\n");
 
   Vector_Destroy(&vector);
+  Vector_ArenaDestroy(&arena);
 
   printf("All allocated memory was freed.\n");
 
@@ -0,0 +1,450 @@
+/*!
+ * \file       bench.cpp
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Benchmarks of the vector module.
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+/* Includes --------------------------------------------------------------------------------------*/
+
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "columnar_vector.h"
+#include "concurrent_vector.h"
+#include "vector.h"
+}
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Order in which the positions of a vector are visited. */
+enum AccessPattern : int64_t { SEQUENTIAL, REVERSE, RANDOM };
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Largest vector length used by the linear time benchmarks. */
+#define MAX_LENGTH 100000000
+
+/*! Largest vector length used by the benchmarks whose time is quadratic in the length. */
+#define MAX_QUADRATIC_LENGTH 100000
+
+/*! Number of items appended by all producers of the concurrent benchmarks together. */
+#define CONCURRENT_LENGTH 10000000
+
+/*! Number of rows appended by the record benchmarks. */
+#define RECORD_COUNT 1000000
+
+/*! Number of fields of one record. */
+#define RECORD_FIELDS 4
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static Vector_t *createFilled(size_t length, size_t alloc_step);
+static std::vector<size_t> positions(size_t length, int64_t pattern);
+static void setThroughput(benchmark::State &state, size_t items);
+
+/* Benchmarks ------------------------------------------------------------------------------------*/
+/*! Appends items one by one to a vector expanded by the fixed alloc_step of range(1). */
+static void BM_AppendFixed(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  for (auto _ : state) {
+    Vector_t *v = Vector_Create(10, state.range(1));
+    for (size_t i = 0; i < length; i++) {
+      Vector_Append(v, i);
+    }
+    benchmark::DoNotOptimize(v->items);
+    Vector_Destroy(&v);
+  }
+  setThroughput(state, length);
+}
+BENCHMARK(BM_AppendFixed)
+  ->ArgNames({"length", "alloc_step"})
+  ->ArgsProduct({benchmark::CreateRange(10, MAX_QUADRATIC_LENGTH * 10, 10), {1, 100, 10000}});
+
+/*! Appends items one by one to a vector with the geometric growth. */
+static void BM_AppendGeometric(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_Growth_t growth = {VECTOR_GROWTH_GEOMETRIC, 0, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+  for (auto _ : state) {
+    Vector_t *v = Vector_CreateWithGrowth(10, &growth);
+    for (size_t i = 0; i < length; i++) {
+      Vector_Append(v, i);
+    }
+    benchmark::DoNotOptimize(v->items);
+    Vector_Destroy(&v);
+  }
+  setThroughput(state, length);
+}
+BENCHMARK(BM_AppendGeometric)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH);
+
+/*! Appends all items by a single call. */
+static void BM_AppendArray(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  std::vector<Vector_DataType_t> values(length, 1);
+  for (auto _ : state) {
+    Vector_t *v = Vector_Create(10, 100);
+    Vector_AppendArray(v, values.data(), length);
+    benchmark::DoNotOptimize(v->items);
+    Vector_Destroy(&v);
+  }
+  setThroughput(state, length);
+}
+BENCHMARK(BM_AppendArray)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH);
+
+/*! Reads all items by Vector_At in the access pattern of range(1). */
+static void BM_At(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v = createFilled(length, 100);
+  std::vector<size_t> order = positions(length, state.range(1));
+  for (auto _ : state) {
+    Vector_DataType_t sum = 0, value;
+    for (size_t position : order) {
+      Vector_At(v, position, &value);
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&v);
+}
+BENCHMARK(BM_At)
+  ->ArgNames({"length", "pattern"})
+  ->ArgsProduct({benchmark::CreateRange(10, MAX_LENGTH, 10), {SEQUENTIAL, RANDOM}});
+
+/*! Removes all items one by one in the access pattern of range(1). */
+static void BM_Remove(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *original = createFilled(length, 100);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector_t *v = Vector_Copy(original);
+    std::mt19937_64 random(1);
+    state.ResumeTiming();
+    for (size_t remaining = length; remaining > 0; remaining--) {
+      size_t position = 0;
+      if (state.range(1) == REVERSE) {
+        position = remaining - 1;
+      } else if (state.range(1) == RANDOM) {
+        position = random() % remaining;
+      }
+      Vector_Remove(v, position);
+    }
+    state.PauseTiming();
+    Vector_Destroy(&v);
+    state.ResumeTiming();
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&original);
+}
+BENCHMARK(BM_Remove)
+  ->ArgNames({"length", "pattern"})
+  ->ArgsProduct(
+    {benchmark::CreateRange(10, MAX_QUADRATIC_LENGTH, 10), {SEQUENTIAL, REVERSE, RANDOM}});
+
+/*! Removes every other item by a single Vector_RemoveIf call. */
+static void BM_RemoveIf(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *original = createFilled(length, 100);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector_t *v = Vector_Copy(original);
+    state.ResumeTiming();
+    Vector_RemoveIf(
+      v, [](Vector_DataType_t value, void *) { return value % 2 == 0; }, nullptr);
+    state.PauseTiming();
+    Vector_Destroy(&v);
+    state.ResumeTiming();
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&original);
+}
+BENCHMARK(BM_RemoveIf)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH);
+
+/*! Searches an unsorted vector for the item at the relative position range(1) (in percent), 100
+ * means a missing item.
+ */
+static void BM_IndexOf(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v = createFilled(length, 100);
+  Vector_Append(v, 0);  // keeps the vector unsorted
+  Vector_DataType_t value = 2 * (length * state.range(1) / 100);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Vector_IndexOf(v, value, 0));
+  }
+  setThroughput(state, state.range(1) == 100 ? length + 1 : length * state.range(1) / 100 + 1);
+  Vector_Destroy(&v);
+}
+BENCHMARK(BM_IndexOf)
+  ->ArgNames({"length", "position"})
+  ->ArgsProduct({benchmark::CreateRange(10, MAX_LENGTH, 10), {0, 50, 100}});
+
+/*! Searches a sorted vector, i.e. by binary search. */
+static void BM_ContainsSorted(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v = createFilled(length, 100);
+  std::mt19937_64 random(1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Vector_Contains(v, random() % (2 * length)));
+  }
+  state.SetItemsProcessed(state.iterations());
+  Vector_Destroy(&v);
+}
+BENCHMARK(BM_ContainsSorted)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH);
+
+/*! Copies the whole vector. */
+static void BM_Copy(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v = createFilled(length, 100);
+  for (auto _ : state) {
+    Vector_t *c = Vector_Copy(v);
+    benchmark::DoNotOptimize(c->items);
+    Vector_Destroy(&c);
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&v);
+}
+BENCHMARK(BM_Copy)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH);
+
+/*! Fills the whole vector. */
+static void BM_Fill(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v = createFilled(length, 100);
+  for (auto _ : state) {
+    Vector_Fill(v, 7, 0, length);
+    benchmark::ClobberMemory();
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&v);
+}
+BENCHMARK(BM_Fill)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH);
+
+/*! Sorts a vector of random items. */
+static void BM_Sort(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  std::mt19937_64 random(1);
+  std::vector<Vector_DataType_t> values(length);
+  std::generate(values.begin(), values.end(), random);
+  Vector_t *v = Vector_Create(length, 100);
+  Vector_t *scratch = Vector_Create(length, 100);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector_Resize(v, 0, 0);
+    Vector_AppendArray(v, values.data(), length);
+    state.ResumeTiming();
+    Vector_SortWithScratch(v, scratch);
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&v);
+  Vector_Destroy(&scratch);
+}
+BENCHMARK(BM_Sort)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH);
+
+/*! Merges two sorted vectors of the same length, range(1) is the number of threads used by
+ * Vector_MergeParallel, 0 selects the sequential Merge.
+ */
+static void BM_Merge(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v1 = createFilled(length, 100);
+  Vector_t *v2 = createFilled(length, 100);
+  Vector_t *result = Vector_Create(2 * length, 100);
+  for (auto _ : state) {
+    Vector_Resize(result, 0, 0);
+    if (state.range(1) == 0) {
+      Merge(result, v1, v2);
+    } else {
+      Vector_MergeParallel(result, v1, v2, state.range(1));
+    }
+    benchmark::DoNotOptimize(result->items);
+  }
+  setThroughput(state, 2 * length);
+  Vector_Destroy(&v1);
+  Vector_Destroy(&v2);
+  Vector_Destroy(&result);
+}
+BENCHMARK(BM_Merge)
+  ->ArgNames({"length", "threads"})
+  ->ArgsProduct({benchmark::CreateRange(10, MAX_LENGTH / 2, 10), {0, 2, 4, 8}});
+
+/*! Appends range(0) items from range(1) producer threads to one shared vector. range(2) selects
+ * the concurrent vector (0) or a plain vector behind a mutex (1), i.e. the scaling of lock free
+ * reservation against serialized producers.
+ */
+static void BM_ConcurrentAppend(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  size_t threadCount = state.range(1);
+  bool locked = state.range(2) != 0;
+  Vector_Growth_t growth = {VECTOR_GROWTH_GEOMETRIC, 0, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+  for (auto _ : state) {
+    ConcurrentVector_t *concurrent = locked ? nullptr : ConcurrentVector_Create(0);
+    Vector_t *plain = locked ? Vector_CreateWithGrowth(10, &growth) : nullptr;
+    std::mutex lock;
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < threadCount; t++) {
+      producers.emplace_back([&, t]() {
+        for (size_t i = t; i < length; i += threadCount) {
+          if (locked) {
+            std::lock_guard<std::mutex> guard(lock);
+            Vector_Append(plain, i);
+          } else {
+            ConcurrentVector_Append(concurrent, i);
+          }
+        }
+      });
+    }
+    for (std::thread &producer : producers) {
+      producer.join();
+    }
+    ConcurrentVector_Destroy(&concurrent);
+    Vector_Destroy(&plain);
+  }
+  setThroughput(state, length);
+}
+BENCHMARK(BM_ConcurrentAppend)
+  ->ArgNames({"length", "threads", "mutex"})
+  ->ArgsProduct({{CONCURRENT_LENGTH}, benchmark::CreateRange(1, 16, 2), {0, 1}})
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+/*! Fills the whole vector by the thread pool, compare with BM_Fill. */
+static void BM_ParallelFill(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v = createFilled(length, 100);
+  for (auto _ : state) {
+    Vector_ParallelFill(v, 7, 0, length);
+    benchmark::ClobberMemory();
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&v);
+}
+BENCHMARK(BM_ParallelFill)
+  ->ArgName("length")
+  ->RangeMultiplier(10)
+  ->Range(10, MAX_LENGTH)
+  ->UseRealTime();
+
+/*! Sums all items by the thread pool. */
+static void BM_Reduce(benchmark::State &state)
+{
+  size_t length = state.range(0);
+  Vector_t *v = createFilled(length, 100);
+  Vector_DataType_t sum;
+  for (auto _ : state) {
+    Vector_Reduce(v, VECTOR_REDUCE_SUM, &sum);
+    benchmark::DoNotOptimize(sum);
+  }
+  setThroughput(state, length);
+  Vector_Destroy(&v);
+}
+BENCHMARK(BM_Reduce)->ArgName("length")->RangeMultiplier(10)->Range(10, MAX_LENGTH)->UseRealTime();
+
+/*! Appends records with RECORD_FIELDS fields to a columnar vector (columnar = 1) or to one vector
+ * per field kept in sync by the caller (columnar = 0).
+ */
+static void BM_AppendRecords(benchmark::State &state)
+{
+  bool columnar = state.range(0);
+  Vector_Growth_t growth = {VECTOR_GROWTH_GEOMETRIC, 0, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+  for (auto _ : state) {
+    ColumnarVector_t *table = ColumnarVector_Create(RECORD_FIELDS, 10);
+    Vector_t *fields[RECORD_FIELDS];
+    for (Vector_t *&field : fields) {
+      field = Vector_CreateWithGrowth(10, &growth);
+    }
+    for (Vector_DataType_t i = 0; i < RECORD_COUNT; i++) {
+      Vector_DataType_t row[RECORD_FIELDS] = {i, i + 1, i + 2, i + 3};
+      if (columnar) {
+        ColumnarVector_AppendRow(table, row);
+      } else {
+        for (size_t f = 0; f < RECORD_FIELDS; f++) {
+          Vector_Append(fields[f], row[f]);
+        }
+      }
+    }
+    benchmark::ClobberMemory();
+    for (Vector_t *&field : fields) {
+      Vector_Destroy(&field);
+    }
+    ColumnarVector_Destroy(&table);
+  }
+  setThroughput(state, RECORD_COUNT * RECORD_FIELDS);
+}
+BENCHMARK(BM_AppendRecords)->ArgName("columnar")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/*! Appends pseudo random values that are not present yet, i.e. Vector_Contains is called before
+ * each append, with (indexed = 1) or without (indexed = 0) the hash index.
+ */
+static void BM_DedupAppend(benchmark::State &state)
+{
+  bool indexed = state.range(1);
+  size_t count = state.range(0);
+  for (auto _ : state) {
+    Vector_t *v = Vector_Create(count, 10);
+    if (indexed) {
+      Vector_BuildIndex(v, false);
+    }
+    for (size_t i = 0; i < count; i++) {
+      Vector_DataType_t value = (i * 0x9E3779B97F4A7C15ull) % (count / 2 + 1);
+      if (!Vector_Contains(v, value)) {
+        Vector_Append(v, value);
+      }
+    }
+    benchmark::DoNotOptimize(v->items);
+    Vector_Destroy(&v);
+  }
+  setThroughput(state, count);
+}
+BENCHMARK(BM_DedupAppend)->ArgNames({"length", "indexed"})->ArgsProduct({{1000, 10000}, {0, 1}});
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Creates a vector of \a length sorted items. */
+static Vector_t *createFilled(size_t length, size_t alloc_step)
+{
+  Vector_t *v = Vector_Create(length, alloc_step);
+  for (size_t i = 0; i < length; i++) {
+    Vector_Append(v, 2 * i);
+  }
+  return v;
+}
+
+/*! Returns all positions of a vector with \a length items in the order given by the \a pattern. */
+static std::vector<size_t> positions(size_t length, int64_t pattern)
+{
+  std::vector<size_t> order(length);
+  for (size_t i = 0; i < length; i++) {
+    order[i] = pattern == REVERSE ? length - 1 - i : i;
+  }
+  if (pattern == RANDOM) {
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(1));
+  }
+  return order;
+}
+
+/*! Reports processed items and bytes, \a items are processed by every iteration. */
+static void setThroughput(benchmark::State &state, size_t items)
+{
+  state.SetItemsProcessed(state.iterations() * items);
+  state.SetBytesProcessed(state.iterations() * items * sizeof(Vector_DataType_t));
+}
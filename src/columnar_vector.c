@@ -0,0 +1,281 @@
+/*!
+ * \file       columnar_vector.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Implementation of columnar_vector.h header file
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "columnar_vector.h"
+#include "vector_kernels.h"
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/* Private macros --------------------------------------------------------------------------------*/
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static bool columnar_expand(ColumnarVector_t *const vector, size_t count);
+static bool columnar_resize(ColumnarVector_t *const vector, size_t capacity);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+ColumnarVector_t *ColumnarVector_Create(size_t column_count, size_t initial_size)
+{
+    return ColumnarVector_CreateWithAllocator(column_count, initial_size, &Vector_DefaultAllocator);
+}
+
+ColumnarVector_t *ColumnarVector_CreateWithAllocator(size_t column_count,
+                                                     size_t initial_size,
+                                                     const Vector_Allocator_t *const allocator)
+{
+    if(allocator == NULL || allocator->alloc == NULL || column_count == 0)
+    {
+        return NULL;
+    }
+
+    ColumnarVector_t *v = allocator->alloc(allocator->context, sizeof(ColumnarVector_t));
+    if(v == NULL)
+    {
+        return NULL;
+    }
+    v->items = NULL;
+    v->column_count = column_count;
+    v->length = 0;
+    v->size = 0;
+    v->allocator = allocator;
+    if(initial_size > 0 && !columnar_resize(v, initial_size))
+    {
+        ColumnarVector_Destroy(&v);
+        return NULL;
+    }
+    return v;
+}
+
+size_t ColumnarVector_Length(const ColumnarVector_t *const vector)
+{
+    if(vector)
+    {
+        return vector->length;
+    }
+    return SIZE_MAX;
+}
+
+bool ColumnarVector_Reserve(ColumnarVector_t *const vector, size_t capacity)
+{
+    if(vector)
+    {
+        return capacity <= vector->size || columnar_resize(vector, capacity);
+    }
+    return false;
+}
+
+size_t ColumnarVector_AppendRow(ColumnarVector_t *const vector, const Vector_DataType_t *const row)
+{
+    if(vector == NULL || row == NULL || !columnar_expand(vector, 1))
+    {
+        return SIZE_MAX;
+    }
+
+    size_t position = vector->length;
+    Vector_DataType_t *item = vector->items + position;
+    for(size_t c = 0; c < vector->column_count; c++, item += vector->size)
+    {
+        *item = row[c];
+    }
+    vector->length++;
+    return position;
+}
+
+size_t ColumnarVector_AppendColumns(ColumnarVector_t *const vector,
+                                    const Vector_DataType_t *const *const columns,
+                                    size_t count)
+{
+    if(vector == NULL || columns == NULL || !columnar_expand(vector, count))
+    {
+        return SIZE_MAX;
+    }
+
+    size_t position = vector->length;
+    for(size_t c = 0; c < vector->column_count && count > 0; c++)
+    {
+        memcpy(vector->items + c * vector->size + position,
+               columns[c],
+               count * sizeof(Vector_DataType_t));
+    }
+    vector->length += count;
+    return position;
+}
+
+bool ColumnarVector_GetRow(const ColumnarVector_t *const vector,
+                           size_t position,
+                           Vector_DataType_t *const row)
+{
+    if(vector == NULL || row == NULL || position >= vector->length)
+    {
+        return false;
+    }
+
+    const Vector_DataType_t *item = vector->items + position;
+    for(size_t c = 0; c < vector->column_count; c++, item += vector->size)
+    {
+        row[c] = *item;
+    }
+    return true;
+}
+
+bool ColumnarVector_At(const ColumnarVector_t *const vector,
+                       size_t position,
+                       size_t column,
+                       Vector_DataType_t *const value)
+{
+    if(vector && value && position < vector->length && column < vector->column_count)
+    {
+        *value = vector->items[column * vector->size + position];
+        return true;
+    }
+    return false;
+}
+
+void ColumnarVector_Set(ColumnarVector_t *const vector,
+                        size_t position,
+                        size_t column,
+                        Vector_DataType_t value)
+{
+    if(vector && position < vector->length && column < vector->column_count)
+    {
+        vector->items[column * vector->size + position] = value;
+    }
+}
+
+Vector_DataType_t *ColumnarVector_Column(const ColumnarVector_t *const vector, size_t column)
+{
+    if(vector && vector->items && column < vector->column_count)
+    {
+        return vector->items + column * vector->size;
+    }
+    return NULL;
+}
+
+size_t ColumnarVector_IndexOf(const ColumnarVector_t *const vector,
+                              size_t column,
+                              Vector_DataType_t value,
+                              size_t from)
+{
+    if(vector == NULL || column >= vector->column_count || from >= vector->length)
+    {
+        return SIZE_MAX;
+    }
+
+    const Vector_DataType_t *items = vector->items + column * vector->size + from;
+    size_t count = vector->length - from;
+    size_t found = vector_kernels_get()->find_first(items, count, value);
+    return found < count ? from + found : SIZE_MAX;
+}
+
+bool ColumnarVector_RemoveRow(ColumnarVector_t *const vector, size_t position)
+{
+    if(vector == NULL || position >= vector->length)
+    {
+        return false;
+    }
+
+    size_t moved = (vector->length - position - 1) * sizeof(Vector_DataType_t);
+    Vector_DataType_t *item = vector->items + position;
+    for(size_t c = 0; c < vector->column_count; c++, item += vector->size)
+    {
+        memmove(item, item + 1, moved);
+    }
+    vector->length--;
+    return true;
+}
+
+bool ColumnarVector_SwapRemoveRow(ColumnarVector_t *const vector, size_t position)
+{
+    if(vector == NULL || position >= vector->length)
+    {
+        return false;
+    }
+
+    size_t last = vector->length - 1;
+    Vector_DataType_t *column = vector->items;
+    for(size_t c = 0; c < vector->column_count; c++, column += vector->size)
+    {
+        column[position] = column[last];
+    }
+    vector->length--;
+    return true;
+}
+
+void ColumnarVector_Destroy(ColumnarVector_t **const vector)
+{
+    if(vector && *vector)
+    {
+        ColumnarVector_t *v = *vector;
+        v->allocator->free(v->allocator->context,
+                           v->items,
+                           v->column_count * v->size * sizeof(Vector_DataType_t));
+        v->allocator->free(v->allocator->context, v, sizeof(ColumnarVector_t));
+        *vector = NULL;
+    }
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Makes room for \a count more rows, the capacity is at least doubled so that appends take
+ * amortized constant time.
+ */
+static bool columnar_expand(ColumnarVector_t *const vector, size_t count)
+{
+    if(count <= vector->size - vector->length)
+    {
+        return true;
+    }
+    if(count > SIZE_MAX - vector->length)
+    {
+        return false;
+    }
+
+    size_t capacity = vector->length + count;
+    if(capacity < vector->size * 2 && vector->size <= SIZE_MAX / 2)
+    {
+        capacity = vector->size * 2;
+    }
+    return columnar_resize(vector, capacity);
+}
+
+/*! Reallocates the block of the columns to hold \a capacity rows. The block is resized by one
+ * reallocation and the columns are then moved to their new offsets from the last one, so a column
+ * is never overwritten before it is moved.
+ */
+static bool columnar_resize(ColumnarVector_t *const vector, size_t capacity)
+{
+    size_t maxRows = SIZE_MAX / sizeof(Vector_DataType_t) / vector->column_count;
+    if(capacity > maxRows - COLUMNAR_VECTOR_ROW_ALIGN)
+    {
+        return false;
+    }
+    capacity = (capacity + COLUMNAR_VECTOR_ROW_ALIGN - 1) / COLUMNAR_VECTOR_ROW_ALIGN
+               * COLUMNAR_VECTOR_ROW_ALIGN;
+
+    size_t rowBytes = vector->column_count * sizeof(Vector_DataType_t);
+    Vector_DataType_t *items = vector->allocator->realloc(vector->allocator->context,
+                                                          vector->items,
+                                                          vector->size * rowBytes,
+                                                          capacity * rowBytes);
+    if(items == NULL)
+    {
+        return false;
+    }
+    for(size_t c = vector->column_count - 1; c > 0; c--)
+    {
+        memmove(items + c * capacity,
+                items + c * vector->size,
+                vector->length * sizeof(Vector_DataType_t));
+    }
+    vector->items = items;
+    vector->size = capacity;
+    return true;
+}
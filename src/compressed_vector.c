@@ -0,0 +1,443 @@
+/*!
+ * \file       compressed_vector.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Implementation of compressed_vector.h header file
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "compressed_vector.h"
+#include "vector_internal.h"
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Decoded block of a compressed vector that is consumed item by item. */
+typedef struct {
+  const CompressedVector_t *vector;
+
+  /*! Next block to decode. */
+  size_t block;
+
+  /*! Items of the last decoded block. */
+  Vector_DataType_t items[COMPRESSED_VECTOR_BLOCK];
+
+  /*! Next unconsumed item and number of decoded items. */
+  size_t position, count;
+} CompressedCursor_t;
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Widest difference that is read by one unaligned 64-bit load at any bit offset. Wider differences
+ * are stored in full 64 bits.
+ */
+#define COMPRESSED_MAX_PACKED_BITS 56
+
+/*! Bytes behind the packed data, so the last difference can be read by a 64-bit load. */
+#define COMPRESSED_PADDING 8
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static size_t compressed_block_length(const CompressedVector_t *vector, size_t block);
+static unsigned compressed_block_bits(const Vector_DataType_t *items, size_t count);
+static void compressed_encode_block(uint8_t *data,
+                                    const Vector_DataType_t *items,
+                                    size_t count,
+                                    unsigned bits);
+static void compressed_decode_block(const CompressedVector_t *vector,
+                                    size_t block,
+                                    Vector_DataType_t *values,
+                                    size_t count);
+static bool compressed_cursor_fill(CompressedCursor_t *cursor);
+static Vector_DataType_t *compressed_cursor_drain(CompressedCursor_t *cursor,
+                                                  Vector_DataType_t *out);
+static uint64_t compressed_load(const uint8_t *bytes);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+CompressedVector_t *CompressedVector_Create(const Vector_t *const vector)
+{
+    if(vector == NULL || !vector->sorted)
+    {
+        return NULL;
+    }
+
+    const Vector_Allocator_t *allocator = vector_derived_allocator(vector);
+    CompressedVector_t *cv = allocator->alloc(allocator->context, sizeof(CompressedVector_t));
+    if(cv == NULL)
+    {
+        return NULL;
+    }
+    cv->length = Vector_Length(vector);
+    cv->block_count = cv->length / COMPRESSED_VECTOR_BLOCK
+                      + (cv->length % COMPRESSED_VECTOR_BLOCK != 0);
+    cv->blocks = NULL;
+    cv->data = NULL;
+    cv->data_size = 0;
+    cv->allocator = allocator;
+    if(cv->length == 0)
+    {
+        return cv;
+    }
+
+    // the widths are chosen first, so the packed data is allocated only once
+    cv->blocks = allocator->alloc(allocator->context,
+                                  cv->block_count * sizeof(CompressedVector_Block_t));
+    if(cv->blocks == NULL)
+    {
+        CompressedVector_Destroy(&cv);
+        return NULL;
+    }
+    size_t dataSize = 0;
+    for(size_t block = 0; block < cv->block_count; block++)
+    {
+        const Vector_DataType_t *items = vector->items + block * COMPRESSED_VECTOR_BLOCK;
+        size_t count = compressed_block_length(cv, block);
+        unsigned bits = compressed_block_bits(items, count);
+        cv->blocks[block] = (CompressedVector_Block_t){
+            .first = items[0],
+            .offset = dataSize,
+            .bits = (uint8_t)bits,
+        };
+        dataSize += (bits * (count - 1) + 7) / 8;
+    }
+
+    cv->data = allocator->alloc(allocator->context, dataSize + COMPRESSED_PADDING);
+    if(cv->data == NULL)
+    {
+        CompressedVector_Destroy(&cv);
+        return NULL;
+    }
+    cv->data_size = dataSize + COMPRESSED_PADDING;
+    memset(cv->data, 0, cv->data_size);
+    for(size_t block = 0; block < cv->block_count; block++)
+    {
+        compressed_encode_block(cv->data + cv->blocks[block].offset,
+                                vector->items + block * COMPRESSED_VECTOR_BLOCK,
+                                compressed_block_length(cv, block),
+                                cv->blocks[block].bits);
+    }
+    return cv;
+}
+
+size_t CompressedVector_Length(const CompressedVector_t *const vector)
+{
+    if(vector)
+    {
+        return vector->length;
+    }
+    return SIZE_MAX;
+}
+
+size_t CompressedVector_MemorySize(const CompressedVector_t *const vector)
+{
+    if(vector)
+    {
+        return sizeof(CompressedVector_t) + vector->block_count * sizeof(CompressedVector_Block_t)
+               + vector->data_size;
+    }
+    return SIZE_MAX;
+}
+
+bool CompressedVector_At(const CompressedVector_t *const vector,
+                         size_t position,
+                         Vector_DataType_t *const value)
+{
+    if(vector == NULL || value == NULL || position >= vector->length)
+    {
+        return false;
+    }
+
+    Vector_DataType_t items[COMPRESSED_VECTOR_BLOCK];
+    size_t offset = position % COMPRESSED_VECTOR_BLOCK;
+    compressed_decode_block(vector, position / COMPRESSED_VECTOR_BLOCK, items, offset + 1);
+    *value = items[offset];
+    return true;
+}
+
+size_t CompressedVector_IndexOf(const CompressedVector_t *const vector, Vector_DataType_t value)
+{
+    if(vector == NULL)
+    {
+        return SIZE_MAX;
+    }
+
+    // number of blocks starting below the value, the first occurrence is in the last of them or it
+    // is the first item of the next block
+    size_t low = 0, high = vector->block_count;
+    while(low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if(vector->blocks[middle].first < value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if(low > 0)
+    {
+        Vector_DataType_t items[COMPRESSED_VECTOR_BLOCK];
+        size_t count = compressed_block_length(vector, low - 1);
+        compressed_decode_block(vector, low - 1, items, count);
+        size_t found = vector_lower_bound(items, count, value);
+        if(found < count)
+        {
+            return items[found] == value ? (low - 1) * COMPRESSED_VECTOR_BLOCK + found : SIZE_MAX;
+        }
+    }
+    if(low < vector->block_count && vector->blocks[low].first == value)
+    {
+        return low * COMPRESSED_VECTOR_BLOCK;
+    }
+    return SIZE_MAX;
+}
+
+bool CompressedVector_Contains(const CompressedVector_t *const vector, Vector_DataType_t value)
+{
+    return CompressedVector_IndexOf(vector, value) != SIZE_MAX;
+}
+
+size_t CompressedVector_Decode(const CompressedVector_t *const vector,
+                               size_t position,
+                               Vector_DataType_t *const values,
+                               size_t count)
+{
+    if(vector == NULL || (values == NULL && count > 0))
+    {
+        return SIZE_MAX;
+    }
+    if(position >= vector->length)
+    {
+        return 0;
+    }
+
+    if(count > vector->length - position)
+    {
+        count = vector->length - position;
+    }
+    size_t decoded = 0;
+    while(decoded < count)
+    {
+        size_t block = (position + decoded) / COMPRESSED_VECTOR_BLOCK;
+        size_t offset = (position + decoded) % COMPRESSED_VECTOR_BLOCK;
+        size_t blockLength = compressed_block_length(vector, block);
+        size_t take = blockLength - offset;
+        if(take > count - decoded)
+        {
+            take = count - decoded;
+        }
+        if(offset == 0)
+        {
+            compressed_decode_block(vector, block, values + decoded, take);
+        }
+        else
+        {
+            Vector_DataType_t items[COMPRESSED_VECTOR_BLOCK];
+            compressed_decode_block(vector, block, items, offset + take);
+            memcpy(values + decoded, items + offset, take * sizeof(Vector_DataType_t));
+        }
+        decoded += take;
+    }
+    return decoded;
+}
+
+bool CompressedVector_Decompress(const CompressedVector_t *const vector, Vector_t *const result)
+{
+    if(vector == NULL || result == NULL || !vector_ensure_capacity(result, vector->length))
+    {
+        return false;
+    }
+
+    size_t appendedAt = Vector_Length(result);
+    for(size_t block = 0; block < vector->block_count; block++)
+    {
+        size_t count = compressed_block_length(vector, block);
+        compressed_decode_block(vector, block, result->next, count);
+        result->next += count;
+    }
+    vector_track_sorted(result, appendedAt, vector->length, false);
+    return true;
+}
+
+bool CompressedVector_Merge(Vector_t *const result,
+                            const CompressedVector_t *const a,
+                            const CompressedVector_t *const b)
+{
+    if(result == NULL || a == NULL || b == NULL || SIZE_MAX - a->length < b->length
+       || !vector_ensure_capacity(result, a->length + b->length))
+    {
+        return false;
+    }
+
+    CompressedCursor_t first = {.vector = a}, second = {.vector = b};
+    size_t appendedAt = Vector_Length(result);
+    Vector_DataType_t *out = result->next;
+    while(compressed_cursor_fill(&first) && compressed_cursor_fill(&second))
+    {
+        while(first.position < first.count && second.position < second.count)
+        {
+            if(first.items[first.position] <= second.items[second.position])
+            {
+                *out++ = first.items[first.position++];
+            }
+            else
+            {
+                *out++ = second.items[second.position++];
+            }
+        }
+    }
+
+    out = compressed_cursor_drain(&first, out);
+    out = compressed_cursor_drain(&second, out);
+    result->next = out;
+    vector_track_sorted(result, appendedAt, a->length + b->length, false);
+    return true;
+}
+
+void CompressedVector_Destroy(CompressedVector_t **const vector)
+{
+    if(vector && *vector)
+    {
+        const Vector_Allocator_t *allocator = (*vector)->allocator;
+        allocator->free(allocator->context, (*vector)->data, (*vector)->data_size);
+        allocator->free(allocator->context,
+                        (*vector)->blocks,
+                        (*vector)->block_count * sizeof(CompressedVector_Block_t));
+        allocator->free(allocator->context, *vector, sizeof(CompressedVector_t));
+        *vector = NULL;
+    }
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+static size_t compressed_block_length(const CompressedVector_t *vector, size_t block)
+{
+    return block + 1 < vector->block_count ? COMPRESSED_VECTOR_BLOCK
+                                           : vector->length - block * COMPRESSED_VECTOR_BLOCK;
+}
+
+/*! Returns the number of bits of the largest difference of adjacent \a items. Widths above \ref
+ * COMPRESSED_MAX_PACKED_BITS are rounded up to 64.
+ */
+static unsigned compressed_block_bits(const Vector_DataType_t *items, size_t count)
+{
+    Vector_DataType_t largest = 0;
+    for(size_t i = 1; i < count; i++)
+    {
+        Vector_DataType_t delta = items[i] - items[i - 1];
+        largest = delta > largest ? delta : largest;
+    }
+    unsigned bits = 0;
+    while(bits < 64 && (largest >> bits) != 0)
+    {
+        bits++;
+    }
+    return bits > COMPRESSED_MAX_PACKED_BITS ? 64 : bits;
+}
+
+/*! Packs the differences of adjacent \a items into the zeroed \a data, the difference of item i is
+ * stored at bit (i - 1) * \a bits. Each difference with its bit offset inside the first byte fits
+ * into 64 bits, so it is ORed into eight consecutive bytes.
+ */
+static void compressed_encode_block(uint8_t *data,
+                                    const Vector_DataType_t *items,
+                                    size_t count,
+                                    unsigned bits)
+{
+    if(bits == 0)
+    {
+        return;
+    }
+    size_t bit = 0;
+    for(size_t i = 1; i < count; i++, bit += bits)
+    {
+        uint64_t shifted = (uint64_t)(items[i] - items[i - 1]) << (bit & 7);
+        for(size_t j = 0; j < 8; j++)
+        {
+            data[(bit >> 3) + j] |= (uint8_t)(shifted >> (8 * j));
+        }
+    }
+}
+
+/*! Decodes the first \a count (at least one) items of the \a block into the \a values. */
+static void compressed_decode_block(const CompressedVector_t *vector,
+                                    size_t block,
+                                    Vector_DataType_t *values,
+                                    size_t count)
+{
+    const CompressedVector_Block_t *entry = &vector->blocks[block];
+    const uint8_t *data = vector->data + entry->offset;
+    unsigned bits = entry->bits;
+    Vector_DataType_t value = entry->first;
+    values[0] = value;
+    if(bits == 0)
+    {
+        for(size_t i = 1; i < count; i++)
+        {
+            values[i] = value;
+        }
+        return;
+    }
+
+    uint64_t mask = bits == 64 ? UINT64_MAX : (UINT64_C(1) << bits) - 1;
+    size_t bit = 0;
+    for(size_t i = 1; i < count; i++, bit += bits)
+    {
+        value += (compressed_load(data + (bit >> 3)) >> (bit & 7)) & mask;
+        values[i] = value;
+    }
+}
+
+/*! Decodes the next block when all items of the \a cursor were consumed. Returns false when there
+ * is no item left.
+ */
+static bool compressed_cursor_fill(CompressedCursor_t *cursor)
+{
+    if(cursor->position < cursor->count)
+    {
+        return true;
+    }
+    if(cursor->block >= cursor->vector->block_count)
+    {
+        return false;
+    }
+    cursor->count = compressed_block_length(cursor->vector, cursor->block);
+    cursor->position = 0;
+    compressed_decode_block(cursor->vector, cursor->block++, cursor->items, cursor->count);
+    return true;
+}
+
+/*! Copies the remaining decoded items of the \a cursor to \a out and decodes the blocks that were
+ * not decoded yet straight behind them. Returns pointer behind the last written item.
+ */
+static Vector_DataType_t *compressed_cursor_drain(CompressedCursor_t *cursor,
+                                                  Vector_DataType_t *out)
+{
+    size_t count = cursor->count - cursor->position;
+    memcpy(out, cursor->items + cursor->position, count * sizeof(Vector_DataType_t));
+    out += count;
+    cursor->position = cursor->count;
+    for(; cursor->block < cursor->vector->block_count; cursor->block++)
+    {
+        count = compressed_block_length(cursor->vector, cursor->block);
+        compressed_decode_block(cursor->vector, cursor->block, out, count);
+        out += count;
+    }
+    return out;
+}
+
+/*! Reads eight little endian bytes, compilers turn the loop into a single load on such hosts. */
+static uint64_t compressed_load(const uint8_t *bytes)
+{
+    uint64_t value = 0;
+    for(size_t i = 0; i < 8; i++)
+    {
+        value |= (uint64_t)bytes[i] << (8 * i);
+    }
+    return value;
+}
@@ -0,0 +1,396 @@
+/*!
+ * \file       concurrent_vector.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Implementation of concurrent_vector.h header file
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "concurrent_vector.h"
+#include "vector_internal.h"
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Number of segments needed to address all positions representable by size_t. */
+#define CONCURRENT_SEGMENTS (sizeof(size_t) * CHAR_BIT - CONCURRENT_VECTOR_FIRST_BITS)
+
+/*! Number of items covered by one counter of written items, see \ref concurrent_ready. */
+#define CONCURRENT_READY_BLOCK 64
+
+/*! Size of a cache line, counters modified by different producers are kept apart. */
+#define CONCURRENT_CACHE_LINE 64
+
+#if CONCURRENT_VECTOR_FIRST_BITS < 6
+  #error "CONCURRENT_VECTOR_FIRST_BITS must be at least 6, segments hold whole ready blocks"
+#endif
+
+/* Private types ---------------------------------------------------------------------------------*/
+struct ConcurrentVector {
+  /*! Segments of the items, NULL until the segment is needed. Pointers are never changed once set,
+   * so the items never move. Each segment is followed by its counters of written items.
+   */
+  _Atomic(Vector_DataType_t *) segments[CONCURRENT_SEGMENTS];
+
+  /*! Number of reserved slots, it is advanced by the producers before they write their items. */
+  atomic_size_t reserved;
+  char reserved_padding[CONCURRENT_CACHE_LINE - sizeof(atomic_size_t)];
+
+  /*! Length of the published prefix, all its items are written, see \ref concurrent_publish. */
+  atomic_size_t published;
+  char published_padding[CONCURRENT_CACHE_LINE - sizeof(atomic_size_t)];
+
+  /*! Serializes allocation of segments, it is never taken by readers. */
+  pthread_mutex_t lock;
+
+  /*! Allocator of the segments and of this structure. */
+  const Vector_Allocator_t *allocator;
+};
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static size_t concurrent_segment_index(size_t position);
+static size_t concurrent_segment_start(size_t segment);
+static size_t concurrent_segment_bytes(size_t segment);
+static Vector_DataType_t *concurrent_segment(ConcurrentVector_t *vector, size_t segment);
+static atomic_uint *concurrent_ready(Vector_DataType_t *items, size_t segment);
+static bool concurrent_write(ConcurrentVector_t *vector,
+                             size_t position,
+                             const Vector_DataType_t *values,
+                             size_t count);
+static size_t concurrent_publish(ConcurrentVector_t *vector);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+ConcurrentVector_t *ConcurrentVector_Create(size_t initial_size)
+{
+    return ConcurrentVector_CreateWithAllocator(initial_size, &Vector_DefaultAllocator);
+}
+
+ConcurrentVector_t *ConcurrentVector_CreateWithAllocator(size_t initial_size,
+                                                         const Vector_Allocator_t *const allocator)
+{
+    if(allocator == NULL || allocator->alloc == NULL)
+    {
+        return NULL;
+    }
+
+    ConcurrentVector_t *v = allocator->alloc(allocator->context, sizeof(ConcurrentVector_t));
+    if(v == NULL)
+    {
+        return NULL;
+    }
+    if(pthread_mutex_init(&v->lock, NULL) != 0)
+    {
+        allocator->free(allocator->context, v, sizeof(ConcurrentVector_t));
+        return NULL;
+    }
+    for(size_t i = 0; i < CONCURRENT_SEGMENTS; i++)
+    {
+        atomic_init(&v->segments[i], NULL);
+    }
+    atomic_init(&v->reserved, 0);
+    atomic_init(&v->published, 0);
+    v->allocator = allocator;
+
+    size_t segmentCount = initial_size > 0 ? concurrent_segment_index(initial_size - 1) + 1 : 0;
+    for(size_t i = 0; i < segmentCount; i++)
+    {
+        if(concurrent_segment(v, i) == NULL)
+        {
+            ConcurrentVector_Destroy(&v);
+            return NULL;
+        }
+    }
+    return v;
+}
+
+size_t ConcurrentVector_Length(const ConcurrentVector_t *const vector)
+{
+    if(vector)
+    {
+        // the partially written block at the end is published by readers only
+        return concurrent_publish((ConcurrentVector_t *)vector);
+    }
+    return SIZE_MAX;
+}
+
+size_t ConcurrentVector_Append(ConcurrentVector_t *const vector, Vector_DataType_t value)
+{
+    return ConcurrentVector_AppendArray(vector, &value, 1);
+}
+
+size_t ConcurrentVector_AppendArray(ConcurrentVector_t *const vector,
+                                    const Vector_DataType_t *const values,
+                                    size_t count)
+{
+    if(vector == NULL || (values == NULL && count > 0))
+    {
+        return SIZE_MAX;
+    }
+    if(count == 0)
+    {
+        return ConcurrentVector_Length(vector);
+    }
+
+    size_t position = atomic_fetch_add_explicit(&vector->reserved, count, memory_order_relaxed);
+    if(count > SIZE_MAX - position || !concurrent_write(vector, position, values, count))
+    {
+        return SIZE_MAX;  // the slots stay unwritten, so nothing behind them is ever published
+    }
+    return position;
+}
+
+bool ConcurrentVector_At(const ConcurrentVector_t *const vector,
+                         size_t position,
+                         Vector_DataType_t *const value)
+{
+    if(vector == NULL || value == NULL || position >= ConcurrentVector_Length(vector))
+    {
+        return false;
+    }
+
+    // the acquire load of the length made the segment and the item visible
+    size_t segment = concurrent_segment_index(position);
+    const Vector_DataType_t *items =
+      atomic_load_explicit(&vector->segments[segment], memory_order_relaxed);
+    *value = items[position - concurrent_segment_start(segment)];
+    return true;
+}
+
+bool ConcurrentVector_Snapshot(const ConcurrentVector_t *const vector, Vector_t *const result)
+{
+    if(vector == NULL || result == NULL)
+    {
+        return false;
+    }
+
+    size_t length = ConcurrentVector_Length(vector);
+    if(!vector_ensure_capacity(result, length))
+    {
+        return false;
+    }
+    size_t appendedAt = Vector_Length(result);
+    for(size_t segment = 0, position = 0; position < length; segment++)
+    {
+        size_t count = (CONCURRENT_VECTOR_FIRST_SEGMENT << segment) < length - position
+                         ? CONCURRENT_VECTOR_FIRST_SEGMENT << segment
+                         : length - position;
+        const Vector_DataType_t *items =
+          atomic_load_explicit(&vector->segments[segment], memory_order_relaxed);
+        memcpy(result->next, items, count * sizeof(Vector_DataType_t));
+        result->next += count;
+        position += count;
+    }
+    vector_track_sorted(result, appendedAt, length, true);
+    return true;
+}
+
+void ConcurrentVector_Destroy(ConcurrentVector_t **const vector)
+{
+    if(vector && *vector)
+    {
+        const Vector_Allocator_t *allocator = (*vector)->allocator;
+        for(size_t i = 0; i < CONCURRENT_SEGMENTS; i++)
+        {
+            Vector_DataType_t *items =
+              atomic_load_explicit(&(*vector)->segments[i], memory_order_relaxed);
+            allocator->free(allocator->context, items, concurrent_segment_bytes(i));
+        }
+        pthread_mutex_destroy(&(*vector)->lock);
+        allocator->free(allocator->context, *vector, sizeof(ConcurrentVector_t));
+        *vector = NULL;
+    }
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Returns index of the segment holding the \a position, i.e. the base 2 logarithm of \a position /
+ * \ref CONCURRENT_VECTOR_FIRST_SEGMENT + 1 rounded down.
+ */
+static size_t concurrent_segment_index(size_t position)
+{
+    size_t blocks = (position >> CONCURRENT_VECTOR_FIRST_BITS) + 1;
+#if defined(__GNUC__)
+    return sizeof(unsigned long long) * CHAR_BIT - 1 - (size_t)__builtin_clzll(blocks);
+#else
+    size_t segment = 0;
+    while(blocks >>= 1)
+    {
+        segment++;
+    }
+    return segment;
+#endif
+}
+
+/*! Returns position of the first item of the \a segment. */
+static size_t concurrent_segment_start(size_t segment)
+{
+    return (CONCURRENT_VECTOR_FIRST_SEGMENT << segment) - CONCURRENT_VECTOR_FIRST_SEGMENT;
+}
+
+/*! Returns size of the \a segment including its counters of written items, or 0 if it does not
+ * fit into size_t.
+ */
+static size_t concurrent_segment_bytes(size_t segment)
+{
+    size_t itemCount = CONCURRENT_VECTOR_FIRST_SEGMENT << segment;
+    size_t counterCount = itemCount / CONCURRENT_READY_BLOCK;
+    if(itemCount > SIZE_MAX / (sizeof(Vector_DataType_t) + sizeof(atomic_uint)))
+    {
+        return 0;
+    }
+    return itemCount * sizeof(Vector_DataType_t) + counterCount * sizeof(atomic_uint);
+}
+
+/*! Returns the \a segment, it is allocated first if it does not exist yet. Producers that need the
+ * same new segment wait for the one that allocates it, others are not affected.
+ */
+static Vector_DataType_t *concurrent_segment(ConcurrentVector_t *vector, size_t segment)
+{
+    Vector_DataType_t *items =
+      atomic_load_explicit(&vector->segments[segment], memory_order_acquire);
+    if(items)
+    {
+        return items;
+    }
+
+    pthread_mutex_lock(&vector->lock);
+    items = atomic_load_explicit(&vector->segments[segment], memory_order_relaxed);
+    size_t bytes = concurrent_segment_bytes(segment);
+    if(items == NULL && bytes > 0)
+    {
+        items = vector->allocator->alloc(vector->allocator->context, bytes);
+        if(items)
+        {
+            atomic_uint *ready = concurrent_ready(items, segment);
+            size_t blockCount =
+              (CONCURRENT_VECTOR_FIRST_SEGMENT << segment) / CONCURRENT_READY_BLOCK;
+            for(size_t i = 0; i < blockCount; i++)
+            {
+                atomic_init(&ready[i], 0);
+            }
+            atomic_store_explicit(&vector->segments[segment], items, memory_order_release);
+        }
+    }
+    pthread_mutex_unlock(&vector->lock);
+    return items;
+}
+
+/*! Returns the counters of written items of the \a segment, which follow its \a items. The counter
+ * of a block of \ref CONCURRENT_READY_BLOCK items reaches the block size when all of them are
+ * written.
+ */
+static atomic_uint *concurrent_ready(Vector_DataType_t *items, size_t segment)
+{
+    return (atomic_uint *)(items + (CONCURRENT_VECTOR_FIRST_SEGMENT << segment));
+}
+
+/*! Copies the items to their reserved slots, they may span several segments. The counters of the
+ * written blocks are advanced afterwards, which releases the items to the thread that publishes
+ * them. The producer that completes a block publishes it.
+ */
+static bool concurrent_write(ConcurrentVector_t *vector,
+                             size_t position,
+                             const Vector_DataType_t *values,
+                             size_t count)
+{
+    bool completed = false;
+    while(count > 0)
+    {
+        size_t segment = concurrent_segment_index(position);
+        Vector_DataType_t *items = concurrent_segment(vector, segment);
+        if(items == NULL)
+        {
+            return false;
+        }
+        size_t offset = position - concurrent_segment_start(segment);
+        size_t written = (CONCURRENT_VECTOR_FIRST_SEGMENT << segment) - offset;
+        if(written > count)
+        {
+            written = count;
+        }
+        memcpy(items + offset, values, written * sizeof(Vector_DataType_t));
+
+        atomic_uint *ready = concurrent_ready(items, segment);
+        for(size_t done = 0; done < written;)
+        {
+            size_t block = (offset + done) / CONCURRENT_READY_BLOCK;
+            size_t inBlock = (block + 1) * CONCURRENT_READY_BLOCK - (offset + done);
+            if(inBlock > written - done)
+            {
+                inBlock = written - done;
+            }
+            unsigned before =
+              atomic_fetch_add_explicit(&ready[block], (unsigned)inBlock, memory_order_release);
+            completed |= before + inBlock == CONCURRENT_READY_BLOCK;
+            done += inBlock;
+        }
+        values += written;
+        position += written;
+        count -= written;
+    }
+    if(completed)
+    {
+        concurrent_publish(vector);
+    }
+    return true;
+}
+
+/*! Advances the published length over the following blocks whose items are all written and
+ * returns it. The last block counts only up to the number of reserved items, which is read after
+ * its counter: every counted item had been reserved before, so the block is complete when its
+ * counter equals the number of its reserved slots. Producers never wait for each other, a producer
+ * that is slow to finish its write only delays publication of the items behind it, which are then
+ * published by the producer completing its block or by the next reader.
+ */
+static size_t concurrent_publish(ConcurrentVector_t *vector)
+{
+    size_t published = atomic_load_explicit(&vector->published, memory_order_acquire);
+    for(;;)
+    {
+        size_t target = published;
+        for(;;)
+        {
+            size_t segment = concurrent_segment_index(target);
+            Vector_DataType_t *items =
+              atomic_load_explicit(&vector->segments[segment], memory_order_acquire);
+            if(items == NULL)
+            {
+                break;
+            }
+            size_t offset = target - concurrent_segment_start(segment);
+            atomic_uint *ready = &concurrent_ready(items, segment)[offset / CONCURRENT_READY_BLOCK];
+            size_t written = atomic_load_explicit(ready, memory_order_acquire);
+            size_t reserved = atomic_load_explicit(&vector->reserved, memory_order_relaxed);
+            if(target >= reserved)
+            {
+                break;
+            }
+            size_t blockStart = target - offset % CONCURRENT_READY_BLOCK;
+            size_t blockEnd = reserved - blockStart < CONCURRENT_READY_BLOCK
+                                ? reserved
+                                : blockStart + CONCURRENT_READY_BLOCK;
+            if(written != blockEnd - blockStart)
+            {
+                break;
+            }
+            target = blockEnd;
+        }
+
+        if(target <= published
+           || atomic_compare_exchange_strong_explicit(&vector->published,
+                                                      &published,
+                                                      target,
+                                                      memory_order_acq_rel,
+                                                      memory_order_acquire))
+        {
+            return target > published ? target : published;
+        }
+    }
+}
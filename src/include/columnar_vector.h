@@ -0,0 +1,166 @@
+/*!
+ * \file    columnar_vector.h
+ * \author  FAI
+ * \date    10/2026
+ * \brief   Headers of the columnar Vector data structure
+ *
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef __COLUMNAR_VECTOR_H
+#define __COLUMNAR_VECTOR_H
+
+/*! \defgroup columnar_vector Columnar vector
+ *  \brief Vector of records with a fixed number of fields stored as a structure of arrays. Each
+ * field has its own contiguous column, so a scan of one field reads only that field and can be
+ * vectorized. Rows are appended and removed as a whole, the capacity is checked once per row and
+ * all columns live in one block that grows by a single reallocation.
+ *  \{
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+
+/* Exported types --------------------------------------------------------------------------------*/
+/*! Structure that describes the columnar vector. */
+typedef struct {
+  /*! Block of all columns, the column c starts at items + c * size. */
+  Vector_DataType_t *items;
+
+  /*! Number of columns, i.e. fields of a row. */
+  size_t column_count;
+
+  /*! Number of stored rows. */
+  size_t length;
+
+  /*! Number of rows each column can hold, it is a multiple of \ref COLUMNAR_VECTOR_ROW_ALIGN. */
+  size_t size;
+
+  /*! Allocator of the vector structure and of the columns. */
+  const Vector_Allocator_t *allocator;
+} ColumnarVector_t;
+
+/* Exported macros -------------------------------------------------------------------------------*/
+/*! The capacity is rounded up to a multiple of this number of rows, so all columns start at the
+ * same offset inside a cache line as the first one.
+ */
+#define COLUMNAR_VECTOR_ROW_ALIGN (64 / sizeof(Vector_DataType_t))
+
+/* Exported variables ----------------------------------------------------------------------------*/
+/* Exported functions declarations ---------------------------------------------------------------*/
+/*! Creates a columnar vector of rows with \a column_count fields. The owner of the returned vector
+ * is the user, who is responsible for freeing it by \ref ColumnarVector_Destroy.
+ *
+ * \param[in]   column_count    Number of columns, it must be at least 1.
+ * \param[in]   initial_size    Number of rows the vector can hold without reallocation.
+ *
+ * \return  Pointer to the allocated vector structure or NULL in case of failure.
+ */
+ColumnarVector_t *ColumnarVector_Create(size_t column_count, size_t initial_size);
+
+/*! Creates a columnar vector like \ref ColumnarVector_Create does, but all its memory is managed by
+ * the \a allocator, which must outlive the vector.
+ *
+ * \return  Pointer to the allocated vector structure or NULL in case of failure, NULL \a allocator
+ * or an \a allocator that cannot allocate new blocks (see \ref Vector_Allocator_t.alloc).
+ */
+ColumnarVector_t *ColumnarVector_CreateWithAllocator(size_t column_count,
+                                                     size_t initial_size,
+                                                     const Vector_Allocator_t *const allocator);
+
+/*! Returns the number of rows stored in a \a vector or SIZE_MAX if the \a vector is NULL. */
+size_t ColumnarVector_Length(const ColumnarVector_t *const vector);
+
+/*! Ensures the \a vector can hold \a capacity rows without reallocation.
+ *
+ * \return  True on success, false if the \a vector is NULL or the reallocation fails, the vector
+ * is not modified then.
+ */
+bool ColumnarVector_Reserve(ColumnarVector_t *const vector, size_t capacity);
+
+/*! Appends a row whose fields are read from the \a row array of \ref
+ * ColumnarVector_t.column_count items.
+ *
+ * \return  Index of the appended row or SIZE_MAX in case of failure, no column is changed then.
+ */
+size_t ColumnarVector_AppendRow(ColumnarVector_t *const vector,
+                                const Vector_DataType_t *const row);
+
+/*! Appends \a count rows given by columns, \a columns[c] is an array of \a count values of the
+ * column c. Each column is copied as one block and the memory is expanded at most once.
+ *
+ * \return  Index of the first appended row (the length of the vector when \a count is 0) or
+ * SIZE_MAX in case of failure, the vector is not modified then.
+ */
+size_t ColumnarVector_AppendColumns(ColumnarVector_t *const vector,
+                                    const Vector_DataType_t *const *const columns,
+                                    size_t count);
+
+/*! Copies the fields of the row with the index \a position into the \a row array of \ref
+ * ColumnarVector_t.column_count items.
+ *
+ * \return  True on success, false if an argument is NULL or the \a position is out of the vector.
+ */
+bool ColumnarVector_GetRow(const ColumnarVector_t *const vector,
+                           size_t position,
+                           Vector_DataType_t *const row);
+
+/*! Reads the field \a column of the row \a position into the \a value.
+ *
+ * \return  True on success, false if an argument is NULL or the item is out of the vector.
+ */
+bool ColumnarVector_At(const ColumnarVector_t *const vector,
+                       size_t position,
+                       size_t column,
+                       Vector_DataType_t *const value);
+
+/*! Sets the field \a column of the row \a position to the \a value, nothing is done when the item
+ * is out of the \a vector.
+ */
+void ColumnarVector_Set(ColumnarVector_t *const vector,
+                        size_t position,
+                        size_t column,
+                        Vector_DataType_t value);
+
+/*! Returns the first item of the \a column, its ColumnarVector_Length() items are contiguous. The
+ * pointer stays valid until the vector is reallocated by an append or \ref ColumnarVector_Reserve.
+ *
+ * \return  Pointer to the column or NULL if the \a vector is NULL, the \a column does not exist or
+ * no memory is allocated yet.
+ */
+Vector_DataType_t *ColumnarVector_Column(const ColumnarVector_t *const vector, size_t column);
+
+/*! Finds the first row at the position \a from or behind it whose field \a column equals the \a
+ * value. The column is searched by the same SIMD kernels as \ref Vector_IndexOf.
+ *
+ * \return  Index of the found row or SIZE_MAX if it is not found or an argument is invalid.
+ */
+size_t ColumnarVector_IndexOf(const ColumnarVector_t *const vector,
+                              size_t column,
+                              Vector_DataType_t value,
+                              size_t from);
+
+/*! Removes the row at the \a position and shifts the following rows by one row up, which is one
+ * block move per column.
+ *
+ * \return  True on success, false if the \a vector is NULL or the \a position is out of it.
+ */
+bool ColumnarVector_RemoveRow(ColumnarVector_t *const vector, size_t position);
+
+/*! Removes the row at the \a position by moving the last row in its place, the order of the rows
+ * is not kept.
+ *
+ * \return  True on success, false if the \a vector is NULL or the \a position is out of it.
+ */
+bool ColumnarVector_SwapRemoveRow(ColumnarVector_t *const vector, size_t position);
+
+/*! Releases all memory of a \a vector, pointer to the \a vector is then set to NULL. */
+void ColumnarVector_Destroy(ColumnarVector_t **const vector);
+
+/*! \} */
+
+#endif  //__COLUMNAR_VECTOR_H
@@ -0,0 +1,142 @@
+/*!
+ * \file    compressed_vector.h
+ * \author  FAI
+ * \date    10/2026
+ * \brief   Headers of the compressed sorted Vector data structure
+ *
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef __COMPRESSED_VECTOR_H
+#define __COMPRESSED_VECTOR_H
+
+/*! \defgroup compressed_vector Compressed vector
+ *  \brief Frozen (read only) copy of a SORTED vector that stores differences of adjacent items
+ * instead of the items. The items are split into blocks of \ref COMPRESSED_VECTOR_BLOCK items, the
+ * first item of each block is kept in a skip table and the remaining differences are bit-packed
+ * with the width of the largest difference of the block. Dense sorted lists, e.g. of identifiers,
+ * thus take a few bits per item instead of 64. Searching goes by binary search over the skip table
+ * followed by decoding of a single block.
+ *  \{
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+
+/* Exported types --------------------------------------------------------------------------------*/
+/*! Entry of the skip table, i.e. description of one block. */
+typedef struct {
+  /*! First item of the block, it is stored in full. */
+  Vector_DataType_t first;
+
+  /*! Offset of the packed differences of the block in \ref CompressedVector_t.data. */
+  size_t offset;
+
+  /*! Number of bits of each packed difference. */
+  uint8_t bits;
+} CompressedVector_Block_t;
+
+/*! Structure that describes the compressed vector. */
+typedef struct {
+  /*! Skip table with one entry per block. */
+  CompressedVector_Block_t *blocks;
+
+  /*! Number of blocks. */
+  size_t block_count;
+
+  /*! Packed differences of all blocks, each block starts at a byte boundary. */
+  uint8_t *data;
+
+  /*! Number of bytes of \ref CompressedVector_t.data including padding. */
+  size_t data_size;
+
+  /*! Number of items. */
+  size_t length;
+
+  /*! Allocator of all memory of the compressed vector. */
+  const Vector_Allocator_t *allocator;
+} CompressedVector_t;
+
+/* Exported macros -------------------------------------------------------------------------------*/
+/*! Number of items in one block. Bigger blocks make the skip table smaller, smaller blocks make
+ * random access faster.
+ */
+#define COMPRESSED_VECTOR_BLOCK 128
+
+/* Exported variables ----------------------------------------------------------------------------*/
+/* Exported functions declarations ---------------------------------------------------------------*/
+/*! Creates a compressed copy of the SORTED \a vector. The memory is allocated by the allocator of
+ * the \a vector (see \ref Vector_CreateWithAllocator).
+ *
+ * \param[in]   vector  Pointer to a sorted vector, see \ref Vector_t.sorted.
+ *
+ * \return  Pointer to the compressed vector or NULL if the \a vector is NULL, not sorted or memory
+ * allocation fails.
+ *
+ * \sa CompressedVector_Destroy
+ */
+CompressedVector_t *CompressedVector_Create(const Vector_t *const vector);
+
+/*! Returns the number of items of a compressed \a vector or SIZE_MAX if the \a vector is NULL. */
+size_t CompressedVector_Length(const CompressedVector_t *const vector);
+
+/*! Returns the number of bytes occupied by a compressed \a vector including its structure and the
+ * skip table, or SIZE_MAX if the \a vector is NULL.
+ */
+size_t CompressedVector_MemorySize(const CompressedVector_t *const vector);
+
+/*! Reads an item at the \a position into the \a value. Only the block of the item is decoded.
+ *
+ * \return  True on success, false if an argument is NULL or the \a position is out of the vector.
+ */
+bool CompressedVector_At(const CompressedVector_t *const vector,
+                         size_t position,
+                         Vector_DataType_t *const value);
+
+/*! Finds the position of the first occurrence of a \a value by binary search over the skip table,
+ * at most one block is decoded.
+ *
+ * \return  Position of the found item or SIZE_MAX if it is not found or the \a vector is NULL.
+ */
+size_t CompressedVector_IndexOf(const CompressedVector_t *const vector, Vector_DataType_t value);
+
+/*! Returns true if the \a vector contains the \a value, see \ref CompressedVector_IndexOf. */
+bool CompressedVector_Contains(const CompressedVector_t *const vector, Vector_DataType_t value);
+
+/*! Decodes \a count items from the \a position into the \a values array.
+ *
+ * \return  Number of decoded items, which is smaller than \a count at the end of the \a vector, or
+ * SIZE_MAX if an argument is NULL.
+ */
+size_t CompressedVector_Decode(const CompressedVector_t *const vector,
+                               size_t position,
+                               Vector_DataType_t *const values,
+                               size_t count);
+
+/*! Appends all items of the compressed \a vector to the \a result vector, which is expanded once.
+ *
+ * \return  True on success, false if an argument is NULL or memory allocation fails.
+ */
+bool CompressedVector_Decompress(const CompressedVector_t *const vector, Vector_t *const result);
+
+/*! Merges two compressed vectors into the \a result vector so that it is still sorted, like \ref
+ * Merge does. The inputs are decoded block by block while they are merged, so they are never
+ * decompressed as a whole. The \a result is expanded only once.
+ *
+ * \return  True on success, false if an argument is NULL or memory allocation fails, the \a result
+ * is not modified then.
+ */
+bool CompressedVector_Merge(Vector_t *const result,
+                            const CompressedVector_t *const a,
+                            const CompressedVector_t *const b);
+
+/*! Releases all memory of a compressed \a vector, pointer to the \a vector is then set to NULL. */
+void CompressedVector_Destroy(CompressedVector_t **const vector);
+
+/*! \} */
+
+#endif  //__COMPRESSED_VECTOR_H
@@ -0,0 +1,113 @@
+/*!
+ * \file    concurrent_vector.h
+ * \author  FAI
+ * \date    10/2026
+ * \brief   Headers of the concurrent Vector data structure
+ *
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef __CONCURRENT_VECTOR_H
+#define __CONCURRENT_VECTOR_H
+
+/*! \defgroup concurrent_vector Concurrent vector
+ *  \brief Append only vector for many producer threads. A producer reserves its slots by an atomic
+ * addition to the number of reserved items and copies its items without waiting for other
+ * producers. The items are stored in segments whose sizes double (\ref
+ * CONCURRENT_VECTOR_FIRST_SEGMENT, twice that, ...) and which are never moved, so the vector grows
+ * without copying and readers are never blocked. \ref ConcurrentVector_Length returns the length
+ * of the longest prefix known to be written completely, all items of the prefix can be read by any
+ * thread while producers still append. The prefix grows by blocks of written items and reaches all
+ * reserved items whenever no write is pending, e.g. after the producers are joined.
+ *  \{
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+
+/* Exported types --------------------------------------------------------------------------------*/
+/*! Concurrent vector, the structure is private because it contains atomic variables. */
+typedef struct ConcurrentVector ConcurrentVector_t;
+
+/* Exported macros -------------------------------------------------------------------------------*/
+#ifndef CONCURRENT_VECTOR_FIRST_BITS
+  /*! Base 2 logarithm of the number of items in the first segment, the segment k holds \ref
+   * CONCURRENT_VECTOR_FIRST_SEGMENT << k items.
+   */
+  #define CONCURRENT_VECTOR_FIRST_BITS 10
+#endif
+
+/*! Number of items of the first segment. */
+#define CONCURRENT_VECTOR_FIRST_SEGMENT ((size_t)1 << CONCURRENT_VECTOR_FIRST_BITS)
+
+/* Exported variables ----------------------------------------------------------------------------*/
+/* Exported functions declarations ---------------------------------------------------------------*/
+/*! Creates a concurrent vector with room for at least \a initial_size items, see \ref
+ * ConcurrentVector_CreateWithAllocator.
+ */
+ConcurrentVector_t *ConcurrentVector_Create(size_t initial_size);
+
+/*! Creates a concurrent vector whose memory is provided by the \a allocator. Segments are allocated
+ * under a lock of the vector, so the \a allocator does not have to be thread safe unless it is
+ * shared with other vectors used concurrently.
+ *
+ * \param[in]   initial_size    Minimal number of items the vector can hold without allocation.
+ * \param[in]   allocator       Allocator of the segments and of the vector structure.
+ *
+ * \return  Pointer to the vector or NULL if the \a allocator is NULL or the allocation fails.
+ *
+ * \sa ConcurrentVector_Destroy
+ */
+ConcurrentVector_t *ConcurrentVector_CreateWithAllocator(size_t initial_size,
+                                                         const Vector_Allocator_t *const allocator);
+
+/*! Returns the number of published items or SIZE_MAX if the \a vector is NULL. It can be called
+ * from any thread, all items below the returned length can be read by \ref ConcurrentVector_At.
+ */
+size_t ConcurrentVector_Length(const ConcurrentVector_t *const vector);
+
+/*! Appends a \a value, the function can be called from many threads at once.
+ *
+ * \return  Position of the item or SIZE_MAX if the allocation of a segment fails. The slot of the
+ * failed item stays reserved, so no item behind it is ever published, the already published ones
+ * stay readable.
+ */
+size_t ConcurrentVector_Append(ConcurrentVector_t *const vector, Vector_DataType_t value);
+
+/*! Appends \a count items from the \a values array as a single block of consecutive positions, the
+ * function can be called from many threads at once. The block is reserved by one atomic operation.
+ *
+ * \return  Position of the first item (the length of the vector when \a count is 0) or SIZE_MAX on
+ * failure, see \ref ConcurrentVector_Append.
+ */
+size_t ConcurrentVector_AppendArray(ConcurrentVector_t *const vector,
+                                    const Vector_DataType_t *const values,
+                                    size_t count);
+
+/*! Reads a published item at the \a position into the \a value, it never waits for producers.
+ *
+ * \return  True on success, false if an argument is NULL or the item is not published.
+ */
+bool ConcurrentVector_At(const ConcurrentVector_t *const vector,
+                         size_t position,
+                         Vector_DataType_t *const value);
+
+/*! Appends all items published so far to the \a result vector, which is expanded once. The
+ * producers may keep appending meanwhile, their new items are not copied.
+ *
+ * \return  True on success, false if an argument is NULL or memory allocation fails.
+ */
+bool ConcurrentVector_Snapshot(const ConcurrentVector_t *const vector, Vector_t *const result);
+
+/*! Releases all memory of a concurrent \a vector, pointer to the \a vector is then set to NULL. No
+ * other thread may use the vector at that time.
+ */
+void ConcurrentVector_Destroy(ConcurrentVector_t **const vector);
+
+/*! \} */
+
+#endif  //__CONCURRENT_VECTOR_H
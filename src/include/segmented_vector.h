@@ -0,0 +1,139 @@
+/*!
+ * \file    segmented_vector.h
+ * \author  FAI
+ * \date    10/2026
+ * \brief   Headers of the segmented Vector data structure
+ *
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef __SEGMENTED_VECTOR_H
+#define __SEGMENTED_VECTOR_H
+
+/*! \defgroup segmented_vector Segmented vector
+ *  \brief Vector whose items are stored in fixed-size chunks referenced from a directory. The
+ * vector grows by adding chunks, so items are never copied on growth, there is no transient
+ * doubling of the memory and the address of an item does not change until items before it are
+ * removed. An item is located by a shift and a mask of its position, i.e. in O(1).
+ *  \{
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+
+/* Exported types --------------------------------------------------------------------------------*/
+/*! Structure that describes the segmented vector. */
+typedef struct {
+  /*! Directory of the allocated chunks, each of them has \ref SEGMENTED_VECTOR_CHUNK_SIZE cells. */
+  Vector_DataType_t **chunks;
+
+  /*! Number of allocated chunks. */
+  size_t chunk_count;
+
+  /*! Number of cells of the \ref SegmentedVector_t.chunks directory. */
+  size_t directory_size;
+
+  /*! Number of items stored in the vector. */
+  size_t length;
+
+  /*! Allocator of the vector structure, the directory and the chunks. */
+  const Vector_Allocator_t *allocator;
+} SegmentedVector_t;
+
+/* Exported macros -------------------------------------------------------------------------------*/
+#ifndef SEGMENTED_VECTOR_CHUNK_BITS
+  /*! Base 2 logarithm of the number of items in one chunk. */
+  #define SEGMENTED_VECTOR_CHUNK_BITS 12
+#endif
+
+/*! Number of items in one chunk. */
+#define SEGMENTED_VECTOR_CHUNK_SIZE ((size_t)1 << SEGMENTED_VECTOR_CHUNK_BITS)
+
+/* Exported variables ----------------------------------------------------------------------------*/
+/* Exported functions declarations ---------------------------------------------------------------*/
+/*! Creates a segmented vector with chunks for at least \a initial_size items. The owner of the
+ * returned vector is the user, who is responsible for freeing it by \ref SegmentedVector_Destroy.
+ *
+ * \param[in]   initial_size    Number of items the vector can hold without allocating a chunk.
+ *
+ * \return  Pointer to the allocated vector structure or NULL in case of failure.
+ */
+SegmentedVector_t *SegmentedVector_Create(size_t initial_size);
+
+/*! Creates a segmented vector like \ref SegmentedVector_Create does, but all its memory is managed
+ * by the \a allocator, which must outlive the vector.
+ *
+ * \return  Pointer to the allocated vector structure or NULL in case of failure, NULL \a allocator
+ * or an \a allocator that cannot allocate new blocks (see \ref Vector_Allocator_t.alloc).
+ */
+SegmentedVector_t *SegmentedVector_CreateWithAllocator(size_t initial_size,
+                                                       const Vector_Allocator_t *const allocator);
+
+/*! Returns the number of items stored in a \a vector or SIZE_MAX if the \a vector is NULL. */
+size_t SegmentedVector_Length(const SegmentedVector_t *const vector);
+
+/*! Appends a \a value to the end of a \a vector. When the last chunk is full, a new chunk is added,
+ * the items already stored are not moved.
+ *
+ * \return  Position of the appended item or SIZE_MAX in case of failure.
+ */
+size_t SegmentedVector_Append(SegmentedVector_t *const vector, Vector_DataType_t value);
+
+/*! Reads an item at the \a position of a \a vector into the \a value.
+ *
+ * \return  True on success, false if an argument is NULL or the \a position is out of the vector.
+ */
+bool SegmentedVector_At(const SegmentedVector_t *const vector,
+                        size_t position,
+                        Vector_DataType_t *const value);
+
+/*! Returns the address of the item at the \a position or NULL if the \a position is out of the
+ * \a vector. The address stays valid until the item is moved by \ref SegmentedVector_Remove of an
+ * item before it or until the \a vector is destroyed, appending never invalidates it.
+ */
+Vector_DataType_t *SegmentedVector_ItemAddress(const SegmentedVector_t *const vector,
+                                               size_t position);
+
+/*! Sets the item at the \a position to the \a value, nothing is done when the \a position is out of
+ * the \a vector.
+ */
+void SegmentedVector_Set(SegmentedVector_t *const vector, size_t position, Vector_DataType_t value);
+
+/*! Sets the items from the \a start_position to the \a end_position (including it) to the \a value.
+ * The range is cropped to the length of the \a vector.
+ */
+void SegmentedVector_Fill(SegmentedVector_t *const vector,
+                          Vector_DataType_t value,
+                          size_t start_position,
+                          size_t end_position);
+
+/*! Finds the position of the first occurrence of a \a value at the position \a from or behind it.
+ * Each chunk is searched by the same SIMD kernels as \ref Vector_IndexOf.
+ *
+ * \return  Position of the found item or SIZE_MAX if it is not found or the \a vector is NULL.
+ */
+size_t SegmentedVector_IndexOf(const SegmentedVector_t *const vector,
+                               Vector_DataType_t value,
+                               size_t from);
+
+/*! Returns true if the \a vector contains the \a value. */
+bool SegmentedVector_Contains(const SegmentedVector_t *const vector, Vector_DataType_t value);
+
+/*! Removes the item at the \a position and shifts the following items by one item to the left.
+ * The shift is done by one block move per chunk. A chunk that becomes unused is kept for the next
+ * appends as long as it is the only unused one.
+ *
+ * \return  True on success, false if the \a vector is NULL or the \a position is out of it.
+ */
+bool SegmentedVector_Remove(SegmentedVector_t *const vector, size_t position);
+
+/*! Releases all memory of a \a vector, pointer to the \a vector is then set to NULL. */
+void SegmentedVector_Destroy(SegmentedVector_t **const vector);
+
+/*! \} */
+
+#endif  //__SEGMENTED_VECTOR_H
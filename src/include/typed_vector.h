@@ -0,0 +1,681 @@
+/*!
+ * \file    typed_vector.h
+ * \author  FAI
+ * \date    10/2026
+ * \brief   Headers of the Vector data structure generated for other item types
+ *
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef __TYPED_VECTOR_H
+#define __TYPED_VECTOR_H
+
+/*! \defgroup typed_vector Typed vector
+ *  \brief Vectors of items of any integer or floating point type, so each dataset is stored in its
+ * natural width instead of \ref Vector_DataType_t. \ref TYPED_VECTOR_DECLARE declares the vector
+ * type Name_t and its functions for an item type, \ref TYPED_VECTOR_DEFINE generates their code in
+ * one C translation unit. The library provides \ref VectorU32_t (uint32_t), \ref VectorI16_t
+ * (int16_t) and \ref VectorF64_t (double), other types are instantiated in the same way:
+ *
+ * \code
+ * // header
+ * TYPED_VECTOR_DECLARE(VectorU8, uint8_t)
+ * // one C source file
+ * TYPED_VECTOR_DEFINE(VectorU8, uint8_t, uint8_t, UNSIGNED)
+ * \endcode
+ *
+ * The generated functions behave like the \ref Vector_t functions of the same names:
+ * - Name_t *Name_Create(size_t initial_size, size_t alloc_step)
+ * - Name_t *Name_CreateWithAllocator(size_t initial_size, size_t alloc_step,
+ *                                    const Vector_Allocator_t *allocator)
+ * - Name_t *Name_Copy(const Name_t *original)
+ * - void Name_Destroy(Name_t **vector)
+ * - size_t Name_Length(const Name_t *vector)
+ * - bool Name_Reserve(Name_t *vector, size_t capacity)
+ * - void Name_Clear(Name_t *vector)
+ * - size_t Name_Append(Name_t *vector, Type value)
+ * - size_t Name_AppendArray(Name_t *vector, const Type *values, size_t count)
+ * - bool Name_At(const Name_t *vector, size_t position, Type *value)
+ * - void Name_Set(Name_t *vector, size_t position, Type value)
+ * - bool Name_Remove(Name_t *vector, size_t position)
+ * - void Name_Fill(Name_t *vector, Type value, size_t start_position, size_t end_position)
+ * - size_t Name_IndexOf(const Name_t *vector, Type value, size_t from)
+ * - size_t Name_CountOf(const Name_t *vector, Type value)
+ * - bool Name_Contains(const Name_t *vector, Type value)
+ * - bool Name_Sort(Name_t *vector)
+ * - bool Name_Merge(Name_t *result, const Name_t *v1, const Name_t *v2)
+ *
+ * Vectors grow by \a alloc_step items like vectors of \ref Vector_Create do, a zero \a alloc_step
+ * doubles the capacity instead. \a Name_Merge appends the merged items of two SORTED vectors to
+ * the \a result like \ref Merge does, it returns false and leaves the \a result unmodified when a
+ * vector is not sorted or the expansion fails.
+ *
+ * Unsorted vectors are searched by loops the compiler turns into SIMD compares, on x86-64 an AVX2
+ * version is selected at run time. Sorted vectors are searched by binary search and sorting uses
+ * LSD radix sort over the order preserving unsigned key of the item, so the number of passes
+ * follows the width of the type. Floating point items are ordered by the IEEE 754 total order,
+ * -0.0 precedes 0.0 and NaNs are placed at the ends. Searches compare the items by ==, whether the
+ * vector is sorted or not, so -0.0 and 0.0 are equal and a NaN is never found.
+ *  \{
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+
+#include <string.h>
+
+/* Exported macros -------------------------------------------------------------------------------*/
+/*! Defined when the code is instrumented by ThreadSanitizer. */
+#if defined(__SANITIZE_THREAD__)
+  #define TYPED_VECTOR_TSAN
+#elif defined(__has_feature)
+  #if __has_feature(thread_sanitizer)
+    #define TYPED_VECTOR_TSAN
+  #endif
+#endif
+
+#if !defined(VECTOR_NO_SIMD) && !defined(TYPED_VECTOR_TSAN) && defined(__GNUC__)                   \
+  && defined(__x86_64__) && defined(__ELF__)
+  /*! Attribute of the search loops, they are compiled for several instruction sets and the best
+   * one supported by the CPU is selected when the program is loaded. The selection runs before
+   * ThreadSanitizer is initialized and crashes the program, so builds with -fsanitize=thread use
+   * only the default version.
+   */
+  #define TYPED_VECTOR_SIMD __attribute__((target_clones("avx2", "default")))
+#else
+  #define TYPED_VECTOR_SIMD
+#endif
+
+/*! Number of items compared in one step of the search loops, it fills one cache line. */
+#define TYPED_VECTOR_LANES(Type) (sizeof(Type) < 64 ? 64 / sizeof(Type) : 1)
+
+/*! Smallest capacity allocated when an empty vector grows. */
+#define TYPED_VECTOR_MIN_CAPACITY 8
+
+/*! The most significant bit of the unsigned \a Key type. */
+#define TYPED_VECTOR_SIGN(Key) ((Key)((Key)1 << (sizeof(Key) * 8 - 1)))
+
+/*! Declares the vector type Name_t of \a Type items and its functions, see \ref typed_vector. The
+ * macro can be used in C and C++ code.
+ *
+ * \param   Name    Prefix of the type and of the functions, e.g. VectorU32.
+ * \param   Type    Type of the items.
+ */
+#define TYPED_VECTOR_DECLARE(Name, Type)                                                           \
+  typedef struct {                                                                                 \
+    Type *items;                                                                                   \
+    Type *next;                                                                                    \
+    size_t size;                                                                                   \
+    size_t alloc_step;                                                                             \
+    bool sorted;                                                                                   \
+    const Vector_Allocator_t *allocator;                                                           \
+  } Name##_t;                                                                                      \
+                                                                                                   \
+  Name##_t *Name##_Create(size_t initial_size, size_t alloc_step);                                 \
+  Name##_t *Name##_CreateWithAllocator(size_t initial_size,                                        \
+                                       size_t alloc_step,                                          \
+                                       const Vector_Allocator_t *const allocator);                 \
+  Name##_t *Name##_Copy(const Name##_t *const original);                                           \
+  void Name##_Destroy(Name##_t **const vector);                                                    \
+  size_t Name##_Length(const Name##_t *const vector);                                              \
+  bool Name##_Reserve(Name##_t *const vector, size_t capacity);                                    \
+  void Name##_Clear(Name##_t *const vector);                                                       \
+  size_t Name##_Append(Name##_t *const vector, Type value);                                        \
+  size_t Name##_AppendArray(Name##_t *const vector, const Type *const values, size_t count);       \
+  bool Name##_At(const Name##_t *const vector, size_t position, Type *const value);                \
+  void Name##_Set(Name##_t *const vector, size_t position, Type value);                            \
+  bool Name##_Remove(Name##_t *const vector, size_t position);                                     \
+  void Name##_Fill(Name##_t *const vector,                                                         \
+                   Type value,                                                                     \
+                   size_t start_position,                                                          \
+                   size_t end_position);                                                           \
+  size_t Name##_IndexOf(const Name##_t *const vector, Type value, size_t from);                    \
+  size_t Name##_CountOf(const Name##_t *const vector, Type value);                                 \
+  bool Name##_Contains(const Name##_t *const vector, Type value);                                  \
+  bool Name##_Sort(Name##_t *const vector);                                                        \
+  bool Name##_Merge(Name##_t *const result, const Name##_t *const v1, const Name##_t *const v2);
+
+/*! Generates the functions declared by \ref TYPED_VECTOR_DECLARE, the macro must be used in a C
+ * translation unit.
+ *
+ * \param   Name    Prefix of the type and of the functions.
+ * \param   Type    Type of the items.
+ * \param   Key     Unsigned integer type of the same width as the \a Type.
+ * \param   Kind    UNSIGNED, SIGNED or FLOAT, it selects the mapping of the items to the keys.
+ */
+#define TYPED_VECTOR_DEFINE(Name, Type, Key, Kind)                                                 \
+  TYPED_VECTOR_DEFINE_KEYS(Name, Type, Key, Kind)                                                  \
+  TYPED_VECTOR_DEFINE_STORAGE(Name, Type)                                                          \
+  TYPED_VECTOR_DEFINE_SEARCH(Name, Type, Key)                                                      \
+  TYPED_VECTOR_DEFINE_SORT(Name, Type, Key)
+
+/*! Bodies of the functions mapping the items to unsigned keys of the same order. */
+#define TYPED_VECTOR_ENCODE_UNSIGNED(Type, Key, value) return (Key)(value);
+#define TYPED_VECTOR_ENCODE_SIGNED(Type, Key, value)                                               \
+  return (Key)((Key)(value) ^ TYPED_VECTOR_SIGN(Key));
+#define TYPED_VECTOR_ENCODE_FLOAT(Type, Key, value)                                                \
+  Key bits;                                                                                        \
+  memcpy(&bits, &(value), sizeof(bits));                                                           \
+  return (bits & TYPED_VECTOR_SIGN(Key)) ? (Key)~bits : (Key)(bits | TYPED_VECTOR_SIGN(Key));
+
+/*! Generates the mapping of the items to the keys, see \ref TYPED_VECTOR_DEFINE. */
+#define TYPED_VECTOR_DEFINE_KEYS(Name, Type, Key, Kind)                                            \
+  static inline Key Name##_encode(Type value)                                                      \
+  {                                                                                                \
+      TYPED_VECTOR_ENCODE_##Kind(Type, Key, value)                                                 \
+  }                                                                                                \
+                                                                                                   \
+  static bool Name##_is_sorted(const Type *items, size_t count)                                    \
+  {                                                                                                \
+      for(size_t i = 1; i < count; i++)                                                            \
+      {                                                                                            \
+          if(Name##_encode(items[i - 1]) > Name##_encode(items[i]))                                \
+          {                                                                                        \
+              return false;                                                                        \
+          }                                                                                        \
+      }                                                                                            \
+      return true;                                                                                 \
+  }
+
+/*! Generates the memory management and the access to the items, see \ref TYPED_VECTOR_DEFINE. */
+#define TYPED_VECTOR_DEFINE_STORAGE(Name, Type)                                                    \
+  static bool Name##_expand(Name##_t *vector, size_t count)                                        \
+  {                                                                                                \
+      size_t itemCount = (size_t)(vector->next - vector->items);                                   \
+      if(count > SIZE_MAX / sizeof(Type) - itemCount)                                              \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      if(itemCount + count <= vector->size)                                                        \
+      {                                                                                            \
+          return true;                                                                             \
+      }                                                                                            \
+      size_t capacity;                                                                             \
+      if(vector->alloc_step > 0)                                                                   \
+      {                                                                                            \
+          capacity = vector->size + vector->alloc_step;                                            \
+          if(capacity < vector->size || capacity < itemCount + count)                              \
+          {                                                                                        \
+              capacity = itemCount + count;                                                        \
+          }                                                                                        \
+      }                                                                                            \
+      else                                                                                         \
+      {                                                                                            \
+          capacity = vector->size < TYPED_VECTOR_MIN_CAPACITY ? TYPED_VECTOR_MIN_CAPACITY          \
+                                                              : vector->size;                      \
+          while(capacity < itemCount + count)                                                      \
+          {                                                                                        \
+              capacity = capacity > SIZE_MAX / sizeof(Type) / 2 ? itemCount + count                \
+                                                                : capacity * 2;                    \
+          }                                                                                        \
+      }                                                                                            \
+      return Name##_Reserve(vector, capacity);                                                     \
+  }                                                                                                \
+                                                                                                   \
+  Name##_t *Name##_Create(size_t initial_size, size_t alloc_step)                                  \
+  {                                                                                                \
+      return Name##_CreateWithAllocator(initial_size, alloc_step, &Vector_DefaultAllocator);       \
+  }                                                                                                \
+                                                                                                   \
+  Name##_t *Name##_CreateWithAllocator(size_t initial_size,                                        \
+                                       size_t alloc_step,                                          \
+                                       const Vector_Allocator_t *const allocator)                  \
+  {                                                                                                \
+      if(allocator == NULL || allocator->alloc == NULL)                                            \
+      {                                                                                            \
+          return NULL;                                                                             \
+      }                                                                                            \
+      Name##_t *vector = allocator->alloc(allocator->context, sizeof(Name##_t));                   \
+      if(vector == NULL)                                                                           \
+      {                                                                                            \
+          return NULL;                                                                             \
+      }                                                                                            \
+      vector->items = NULL;                                                                        \
+      vector->next = NULL;                                                                         \
+      vector->size = 0;                                                                            \
+      vector->alloc_step = alloc_step;                                                             \
+      vector->sorted = true;                                                                       \
+      vector->allocator = allocator;                                                               \
+      if(initial_size > 0 && !Name##_Reserve(vector, initial_size))                                \
+      {                                                                                            \
+          allocator->free(allocator->context, vector, sizeof(Name##_t));                           \
+          return NULL;                                                                             \
+      }                                                                                            \
+      return vector;                                                                               \
+  }                                                                                                \
+                                                                                                   \
+  Name##_t *Name##_Copy(const Name##_t *const original)                                            \
+  {                                                                                                \
+      if(original == NULL)                                                                         \
+      {                                                                                            \
+          return NULL;                                                                             \
+      }                                                                                            \
+      Name##_t *copy = Name##_CreateWithAllocator(original->size,                                  \
+                                                  original->alloc_step,                            \
+                                                  original->allocator);                            \
+      if(copy && Name##_AppendArray(copy, original->items, Name##_Length(original)) == SIZE_MAX)   \
+      {                                                                                            \
+          Name##_Destroy(&copy);                                                                   \
+      }                                                                                            \
+      return copy;                                                                                 \
+  }                                                                                                \
+                                                                                                   \
+  void Name##_Destroy(Name##_t **const vector)                                                     \
+  {                                                                                                \
+      if(vector && *vector)                                                                        \
+      {                                                                                            \
+          const Vector_Allocator_t *allocator = (*vector)->allocator;                              \
+          Name##_Clear(*vector);                                                                   \
+          allocator->free(allocator->context, *vector, sizeof(Name##_t));                          \
+          *vector = NULL;                                                                          \
+      }                                                                                            \
+  }                                                                                                \
+                                                                                                   \
+  size_t Name##_Length(const Name##_t *const vector)                                               \
+  {                                                                                                \
+      return vector ? (size_t)(vector->next - vector->items) : SIZE_MAX;                           \
+  }                                                                                                \
+                                                                                                   \
+  bool Name##_Reserve(Name##_t *const vector, size_t capacity)                                     \
+  {                                                                                                \
+      if(vector == NULL || capacity > SIZE_MAX / sizeof(Type))                                     \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      if(capacity <= vector->size)                                                                 \
+      {                                                                                            \
+          return true;                                                                             \
+      }                                                                                            \
+      size_t itemCount = (size_t)(vector->next - vector->items);                                   \
+      Type *items = vector->allocator->realloc(vector->allocator->context,                         \
+                                               vector->items,                                      \
+                                               vector->size * sizeof(Type),                        \
+                                               capacity * sizeof(Type));                           \
+      if(items == NULL)                                                                            \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      vector->items = items;                                                                       \
+      vector->next = items + itemCount;                                                            \
+      vector->size = capacity;                                                                     \
+      return true;                                                                                 \
+  }                                                                                                \
+                                                                                                   \
+  void Name##_Clear(Name##_t *const vector)                                                        \
+  {                                                                                                \
+      if(vector)                                                                                   \
+      {                                                                                            \
+          vector->allocator->free(vector->allocator->context,                                      \
+                                  vector->items,                                                   \
+                                  vector->size * sizeof(Type));                                    \
+          vector->items = NULL;                                                                    \
+          vector->next = NULL;                                                                     \
+          vector->size = 0;                                                                        \
+          vector->sorted = true;                                                                   \
+      }                                                                                            \
+  }                                                                                                \
+                                                                                                   \
+  size_t Name##_Append(Name##_t *const vector, Type value)                                         \
+  {                                                                                                \
+      if(vector == NULL || !Name##_expand(vector, 1))                                              \
+      {                                                                                            \
+          return SIZE_MAX;                                                                         \
+      }                                                                                            \
+      size_t position = (size_t)(vector->next - vector->items);                                    \
+      if(position > 0 && vector->sorted)                                                           \
+      {                                                                                            \
+          vector->sorted = Name##_encode(vector->next[-1]) <= Name##_encode(value);                \
+      }                                                                                            \
+      *vector->next++ = value;                                                                     \
+      return position;                                                                             \
+  }                                                                                                \
+                                                                                                   \
+  size_t Name##_AppendArray(Name##_t *const vector, const Type *const values, size_t count)        \
+  {                                                                                                \
+      if(vector == NULL || (values == NULL && count > 0) || !Name##_expand(vector, count))         \
+      {                                                                                            \
+          return SIZE_MAX;                                                                         \
+      }                                                                                            \
+      size_t position = (size_t)(vector->next - vector->items);                                    \
+      if(count > 0)                                                                                \
+      {                                                                                            \
+          memcpy(vector->next, values, count * sizeof(Type));                                      \
+          if(vector->sorted)                                                                       \
+          {                                                                                        \
+              size_t first = position > 0 ? position - 1 : 0;                                      \
+              vector->sorted = Name##_is_sorted(vector->items + first, position + count - first);  \
+          }                                                                                        \
+          vector->next += count;                                                                   \
+      }                                                                                            \
+      return position;                                                                             \
+  }                                                                                                \
+                                                                                                   \
+  bool Name##_At(const Name##_t *const vector, size_t position, Type *const value)                 \
+  {                                                                                                \
+      if(vector == NULL || value == NULL || position >= Name##_Length(vector))                     \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      *value = vector->items[position];                                                            \
+      return true;                                                                                 \
+  }                                                                                                \
+                                                                                                   \
+  void Name##_Set(Name##_t *const vector, size_t position, Type value)                             \
+  {                                                                                                \
+      size_t itemCount = Name##_Length(vector);                                                    \
+      if(vector && position < itemCount)                                                           \
+      {                                                                                            \
+          vector->items[position] = value;                                                         \
+          if(vector->sorted)                                                                       \
+          {                                                                                        \
+              size_t first = position > 0 ? position - 1 : 0;                                      \
+              size_t last = position + 1 < itemCount ? position + 1 : position;                    \
+              vector->sorted = Name##_is_sorted(vector->items + first, last - first + 1);          \
+          }                                                                                        \
+      }                                                                                            \
+  }                                                                                                \
+                                                                                                   \
+  bool Name##_Remove(Name##_t *const vector, size_t position)                                      \
+  {                                                                                                \
+      size_t itemCount = Name##_Length(vector);                                                    \
+      if(vector == NULL || position >= itemCount)                                                  \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      memmove(vector->items + position,                                                            \
+              vector->items + position + 1,                                                        \
+              (itemCount - position - 1) * sizeof(Type));                                          \
+      vector->next--;                                                                              \
+      return true;                                                                                 \
+  }                                                                                                \
+                                                                                                   \
+  void Name##_Fill(Name##_t *const vector,                                                         \
+                   Type value,                                                                     \
+                   size_t start_position,                                                          \
+                   size_t end_position)                                                            \
+  {                                                                                                \
+      size_t itemCount = Name##_Length(vector);                                                    \
+      if(vector == NULL || start_position >= itemCount)                                            \
+      {                                                                                            \
+          return;                                                                                  \
+      }                                                                                            \
+      size_t end = end_position < itemCount ? end_position + 1 : itemCount;                        \
+      for(size_t i = start_position; i < end; i++)                                                 \
+      {                                                                                            \
+          vector->items[i] = value;                                                                \
+      }                                                                                            \
+      if(vector->sorted)                                                                           \
+      {                                                                                            \
+          size_t first = start_position > 0 ? start_position - 1 : start_position;                 \
+          size_t last = end < itemCount ? end : end - 1;                                           \
+          vector->sorted = (first == start_position                                                \
+                            || Name##_encode(vector->items[first]) <= Name##_encode(value))        \
+                           && Name##_encode(value) <= Name##_encode(vector->items[last]);          \
+      }                                                                                            \
+  }
+
+/*! Generates the search functions, see \ref TYPED_VECTOR_DEFINE. The loops compare a cache line
+ * of items without branches and are left only at its end, so they are vectorized.
+ */
+#define TYPED_VECTOR_DEFINE_SEARCH(Name, Type, Key)                                                \
+  TYPED_VECTOR_SIMD static size_t Name##_find(const Type *items, size_t count, Type value)         \
+  {                                                                                                \
+      size_t i = 0;                                                                                \
+      for(; i + TYPED_VECTOR_LANES(Type) <= count; i += TYPED_VECTOR_LANES(Type))                  \
+      {                                                                                            \
+          Key found = 0;                                                                           \
+          for(size_t j = 0; j < TYPED_VECTOR_LANES(Type); j++)                                     \
+          {                                                                                        \
+              found += items[i + j] == value;                                                      \
+          }                                                                                        \
+          if(found)                                                                                \
+          {                                                                                        \
+              break;                                                                               \
+          }                                                                                        \
+      }                                                                                            \
+      for(; i < count; i++)                                                                        \
+      {                                                                                            \
+          if(items[i] == value)                                                                    \
+          {                                                                                        \
+              return i;                                                                            \
+          }                                                                                        \
+      }                                                                                            \
+      return count;                                                                                \
+  }                                                                                                \
+                                                                                                   \
+  TYPED_VECTOR_SIMD static size_t Name##_count(const Type *items, size_t count, Type value)        \
+  {                                                                                                \
+      size_t found = 0, i = 0;                                                                     \
+      for(; i + TYPED_VECTOR_LANES(Type) <= count; i += TYPED_VECTOR_LANES(Type))                  \
+      {                                                                                            \
+          Key line = 0;                                                                            \
+          for(size_t j = 0; j < TYPED_VECTOR_LANES(Type); j++)                                     \
+          {                                                                                        \
+              line += items[i + j] == value;                                                       \
+          }                                                                                        \
+          found += line;                                                                           \
+      }                                                                                            \
+      for(; i < count; i++)                                                                        \
+      {                                                                                            \
+          found += items[i] == value;                                                              \
+      }                                                                                            \
+      return found;                                                                                \
+  }                                                                                                \
+                                                                                                   \
+  static size_t Name##_lower_bound(const Type *items, size_t first, size_t last, Key key)          \
+  {                                                                                                \
+      while(first < last)                                                                          \
+      {                                                                                            \
+          size_t middle = first + (last - first) / 2;                                              \
+          if(Name##_encode(items[middle]) < key)                                                   \
+          {                                                                                        \
+              first = middle + 1;                                                                  \
+          }                                                                                        \
+          else                                                                                     \
+          {                                                                                        \
+              last = middle;                                                                       \
+          }                                                                                        \
+      }                                                                                            \
+      return first;                                                                                \
+  }                                                                                                \
+                                                                                                   \
+  size_t Name##_IndexOf(const Name##_t *const vector, Type value, size_t from)                     \
+  {                                                                                                \
+      size_t itemCount = Name##_Length(vector);                                                    \
+      if(vector == NULL || from >= itemCount)                                                      \
+      {                                                                                            \
+          return SIZE_MAX;                                                                         \
+      }                                                                                            \
+      if(vector->sorted)                                                                           \
+      {                                                                                            \
+          /* the first item equal to a zero is the first -0.0 of floating point types */           \
+          Key key = Name##_encode(value == 0 ? (Type)-(Type)0 : value);                            \
+          size_t position = Name##_lower_bound(vector->items, from, itemCount, key);               \
+          return position < itemCount && vector->items[position] == value ? position : SIZE_MAX;   \
+      }                                                                                            \
+      size_t position = from + Name##_find(vector->items + from, itemCount - from, value);         \
+      return position < itemCount ? position : SIZE_MAX;                                           \
+  }                                                                                                \
+                                                                                                   \
+  size_t Name##_CountOf(const Name##_t *const vector, Type value)                                  \
+  {                                                                                                \
+      return vector ? Name##_count(vector->items, Name##_Length(vector), value) : 0;               \
+  }                                                                                                \
+                                                                                                   \
+  bool Name##_Contains(const Name##_t *const vector, Type value)                                   \
+  {                                                                                                \
+      return Name##_IndexOf(vector, value, 0) != SIZE_MAX;                                         \
+  }
+
+/*! Generates the sort, see \ref TYPED_VECTOR_DEFINE. Vectors with at least \ref
+ * VECTOR_SORT_RADIX_MIN items are sorted by LSD radix sort of the keys with 8 bit digits, one
+ * pass per byte of the \a Type, passes over digits shared by all items are skipped. Smaller
+ * vectors, or when the buffer of the radix sort cannot be allocated, are sorted by heap sort. The
+ * merge takes the item of the first vector when the keys are equal.
+ */
+#define TYPED_VECTOR_DEFINE_SORT(Name, Type, Key)                                                  \
+  static void Name##_radix_sort(Type *items, Type *buffer, size_t count)                           \
+  {                                                                                                \
+      size_t histogram[sizeof(Key)][256];                                                          \
+      memset(histogram, 0, sizeof(histogram));                                                     \
+      for(size_t i = 0; i < count; i++)                                                            \
+      {                                                                                            \
+          Key key = Name##_encode(items[i]);                                                       \
+          for(size_t pass = 0; pass < sizeof(Key); pass++)                                         \
+          {                                                                                        \
+              histogram[pass][(key >> (pass * 8)) & 0xFF]++;                                       \
+          }                                                                                        \
+      }                                                                                            \
+                                                                                                   \
+      Type *from = items;                                                                          \
+      Type *to = buffer;                                                                           \
+      for(size_t pass = 0; pass < sizeof(Key); pass++)                                             \
+      {                                                                                            \
+          size_t *buckets = histogram[pass];                                                       \
+          unsigned shift = (unsigned)(pass * 8);                                                   \
+          if(buckets[(Name##_encode(from[0]) >> shift) & 0xFF] == count)                           \
+          {                                                                                        \
+              continue;                                                                            \
+          }                                                                                        \
+          size_t offset = 0;                                                                       \
+          for(size_t bucket = 0; bucket < 256; bucket++)                                           \
+          {                                                                                        \
+              size_t bucketCount = buckets[bucket];                                                \
+              buckets[bucket] = offset;                                                            \
+              offset += bucketCount;                                                               \
+          }                                                                                        \
+          for(size_t i = 0; i < count; i++)                                                        \
+          {                                                                                        \
+              to[buckets[(Name##_encode(from[i]) >> shift) & 0xFF]++] = from[i];                   \
+          }                                                                                        \
+          Type *swap = from;                                                                       \
+          from = to;                                                                               \
+          to = swap;                                                                               \
+      }                                                                                            \
+      if(from != items)                                                                            \
+      {                                                                                            \
+          memcpy(items, from, count * sizeof(Type));                                               \
+      }                                                                                            \
+  }                                                                                                \
+                                                                                                   \
+  static void Name##_sift_down(Type *items, size_t root, size_t count)                             \
+  {                                                                                                \
+      for(size_t child = 2 * root + 1; child < count; child = 2 * root + 1)                        \
+      {                                                                                            \
+          if(child + 1 < count && Name##_encode(items[child]) < Name##_encode(items[child + 1]))   \
+          {                                                                                        \
+              child++;                                                                             \
+          }                                                                                        \
+          if(Name##_encode(items[root]) >= Name##_encode(items[child]))                            \
+          {                                                                                        \
+              return;                                                                              \
+          }                                                                                        \
+          Type swap = items[root];                                                                 \
+          items[root] = items[child];                                                              \
+          items[child] = swap;                                                                     \
+          root = child;                                                                            \
+      }                                                                                            \
+  }                                                                                                \
+                                                                                                   \
+  bool Name##_Sort(Name##_t *const vector)                                                         \
+  {                                                                                                \
+      if(vector == NULL)                                                                           \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      if(vector->sorted)                                                                           \
+      {                                                                                            \
+          return true;                                                                             \
+      }                                                                                            \
+                                                                                                   \
+      size_t itemCount = Name##_Length(vector);                                                    \
+      const Vector_Allocator_t *allocator = vector->allocator;                                     \
+      Type *buffer = itemCount >= VECTOR_SORT_RADIX_MIN                                            \
+                       ? allocator->alloc(allocator->context, itemCount * sizeof(Type))            \
+                       : NULL;                                                                     \
+      if(buffer)                                                                                   \
+      {                                                                                            \
+          Name##_radix_sort(vector->items, buffer, itemCount);                                     \
+          allocator->free(allocator->context, buffer, itemCount * sizeof(Type));                   \
+      }                                                                                            \
+      else                                                                                         \
+      {                                                                                            \
+          for(size_t i = itemCount / 2; i > 0; i--)                                                \
+          {                                                                                        \
+              Name##_sift_down(vector->items, i - 1, itemCount);                                   \
+          }                                                                                        \
+          for(size_t end = itemCount; end > 1; end--)                                              \
+          {                                                                                        \
+              Type swap = vector->items[0];                                                        \
+              vector->items[0] = vector->items[end - 1];                                           \
+              vector->items[end - 1] = swap;                                                       \
+              Name##_sift_down(vector->items, 0, end - 1);                                         \
+          }                                                                                        \
+      }                                                                                            \
+      vector->sorted = true;                                                                       \
+      return true;                                                                                 \
+  }                                                                                                \
+                                                                                                   \
+  bool Name##_Merge(Name##_t *const result, const Name##_t *const v1, const Name##_t *const v2)    \
+  {                                                                                                \
+      if(result == NULL || v1 == NULL || v2 == NULL || !v1->sorted || !v2->sorted)                 \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      size_t n1 = Name##_Length(v1), n2 = Name##_Length(v2);                                       \
+      if(SIZE_MAX - n1 < n2 || !Name##_expand(result, n1 + n2))                                    \
+      {                                                                                            \
+          return false;                                                                            \
+      }                                                                                            \
+      if(n1 + n2 == 0)                                                                             \
+      {                                                                                            \
+          return true;                                                                             \
+      }                                                                                            \
+                                                                                                   \
+      /* the items are read after the expansion because result may be one of the inputs */         \
+      const Type *a = v1->items, *b = v2->items;                                                   \
+      size_t i = 0, j = 0, position = Name##_Length(result);                                       \
+      Type *out = result->next;                                                                    \
+      while(i < n1 && j < n2)                                                                      \
+      {                                                                                            \
+          *out++ = Name##_encode(b[j]) < Name##_encode(a[i]) ? b[j++] : a[i++];                    \
+      }                                                                                            \
+      if(i < n1)                                                                                   \
+      {                                                                                            \
+          memcpy(out, a + i, (n1 - i) * sizeof(Type));                                             \
+      }                                                                                            \
+      if(j < n2)                                                                                   \
+      {                                                                                            \
+          memcpy(out, b + j, (n2 - j) * sizeof(Type));                                             \
+      }                                                                                            \
+      result->next += n1 + n2;                                                                     \
+      if(result->sorted && position > 0)                                                           \
+      {                                                                                            \
+          result->sorted = Name##_is_sorted(result->items + position - 1, 2);                      \
+      }                                                                                            \
+      return true;                                                                                 \
+  }
+
+/* Exported types --------------------------------------------------------------------------------*/
+/*! \struct VectorU32_t
+ *  \brief Vector of uint32_t items, e.g. identifiers.
+ */
+TYPED_VECTOR_DECLARE(VectorU32, uint32_t)
+
+/*! \struct VectorI16_t
+ *  \brief Vector of int16_t items, e.g. audio samples.
+ */
+TYPED_VECTOR_DECLARE(VectorI16, int16_t)
+
+/*! \struct VectorF64_t
+ *  \brief Vector of double items.
+ */
+TYPED_VECTOR_DECLARE(VectorF64, double)
+
+/*! \} */
+
+#endif  //__TYPED_VECTOR_H
@@ -25,11 +25,194 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 /* Exported types --------------------------------------------------------------------------------*/
 /*! Data type that is stored in the vector. */
 typedef uint64_t Vector_DataType_t;
 
+/*! Strategy used to compute a new capacity of the vector when \ref Vector_t.items is full. */
+typedef enum {
+  /*! Capacity is increased by \ref Vector_t.alloc_step cells on each expansion. Reallocation count
+   * grows linearly with the number of items, but there is never more than \ref Vector_t.alloc_step
+   * unused cells. */
+  VECTOR_GROWTH_FIXED = 0,
+
+  /*! Capacity is multiplied by \ref Vector_t.growth_factor on each expansion, which gives
+   * amortized constant time of \ref Vector_Append. */
+  VECTOR_GROWTH_GEOMETRIC,
+
+  /*! Capacity is increased by \ref Vector_t.alloc_step until it reaches \ref
+   * Vector_t.growth_threshold cells, then it is multiplied by \ref Vector_t.growth_factor. */
+  VECTOR_GROWTH_HYBRID,
+} Vector_GrowthPolicy_t;
+
+/*! Growth configuration passed to \ref Vector_CreateWithGrowth. */
+typedef struct {
+  /*! Strategy of the expansion. */
+  Vector_GrowthPolicy_t policy;
+
+  /*! Number of cells allocated during expanding (\ref VECTOR_GROWTH_FIXED and \ref
+   * VECTOR_GROWTH_HYBRID only). */
+  size_t alloc_step;
+
+  /*! Multiplier of the capacity, must be greater than 1 (\ref VECTOR_GROWTH_GEOMETRIC and \ref
+   * VECTOR_GROWTH_HYBRID only). */
+  double factor;
+
+  /*! Capacity from which \ref VECTOR_GROWTH_HYBRID switches to the geometric growth. */
+  size_t threshold;
+} Vector_Growth_t;
+
+/*! Table of memory management functions used by a vector for its structure and \ref
+ * Vector_t.items. Every function receives the \ref Vector_Allocator_t.context as the first
+ * argument and the size of the block it operates on, so allocators that keep no block headers
+ * (e.g. pools or counting wrappers) can be implemented on top of it.
+ */
+typedef struct {
+  /*! Allocates a block of \a size bytes, returns NULL in case of failure. It is NULL for allocators
+   * that manage the storage of a single vector only (see \ref Vector_OpenMapped), copies of such a
+   * vector and temporary buffers then use \ref Vector_DefaultAllocator. */
+  void *(*alloc)(void *context, size_t size);
+
+  /*! Resizes the block \a ptr of \a old_size bytes to \a new_size bytes like realloc does, \a ptr
+   * may be NULL (\a old_size is 0 then). The original block is kept when NULL is returned. */
+  void *(*realloc)(void *context, void *ptr, size_t old_size, size_t new_size);
+
+  /*! Releases the block \a ptr of \a size bytes, \a ptr may be NULL. */
+  void (*free)(void *context, void *ptr, size_t size);
+
+  /*! User data passed to all functions of the table. */
+  void *context;
+} Vector_Allocator_t;
+
+/*! Allocation statistics collected by \ref Vector_CountingAllocator_t. */
+typedef struct {
+  /*! Number of blocks allocated by \ref Vector_Allocator_t.alloc. */
+  size_t allocations;
+
+  /*! Number of successful calls of \ref Vector_Allocator_t.realloc. */
+  size_t reallocations;
+
+  /*! Number of released blocks. */
+  size_t frees;
+
+  /*! Number of bytes copied because a reallocated block had to be moved to another address. */
+  size_t bytes_moved;
+
+  /*! Number of bytes that are currently allocated. */
+  size_t live_bytes;
+
+  /*! Maximal value of \ref Vector_AllocStats_t.live_bytes. */
+  size_t peak_bytes;
+} Vector_AllocStats_t;
+
+/*! Allocator that forwards all requests to the \ref Vector_CountingAllocator_t.backend and counts
+ * them. One instance can be shared by several vectors or each vector can have its own to get per
+ * vector statistics. The counters are not synchronized, so an instance must not be used by vectors
+ * modified from different threads at the same time.
+ *
+ * \sa Vector_CountingAllocatorInit
+ */
+typedef struct {
+  /*! Allocator table that is passed to \ref Vector_CreateWithAllocator. */
+  Vector_Allocator_t allocator;
+
+  /*! Allocator that actually manages the memory. */
+  const Vector_Allocator_t *backend;
+
+  /*! Statistics collected since the initialization or the last \ref
+   * Vector_CountingAllocatorReset. */
+  Vector_AllocStats_t stats;
+} Vector_CountingAllocator_t;
+
+/*! Access mode of a file opened by \ref Vector_OpenMapped. */
+typedef enum {
+  /*! The file must exist, the vector can be modified in memory, but the changes are never written
+   * to the file and the vector cannot grow. */
+  VECTOR_MAP_READ_ONLY = 0,
+
+  /*! The file must exist, all changes are written to it. */
+  VECTOR_MAP_READ_WRITE,
+
+  /*! The file is created or truncated to an empty vector, all changes are written to it. */
+  VECTOR_MAP_CREATE,
+} Vector_MapMode_t;
+
+/*! Operation combining all items of a vector into one value, see \ref Vector_Reduce. */
+typedef enum {
+  /*! Sum of the items, it wraps around on overflow like the unsigned arithmetic does. */
+  VECTOR_REDUCE_SUM = 0,
+
+  /*! The smallest item. */
+  VECTOR_REDUCE_MIN,
+
+  /*! The largest item. */
+  VECTOR_REDUCE_MAX,
+} Vector_ReduceOp_t;
+
+/*! Running Fletcher-64 checksum of the items stored by \ref Vector_Save. */
+typedef struct {
+  /*! Sum of the 32 bit words of the items and sum of the first sums, both modulo 2^32 - 1. */
+  uint64_t sum1, sum2;
+} Vector_Checksum_t;
+
+/*! State of a streaming reader of a vector saved by \ref Vector_Save. The items are appended to a
+ * vector in chunks of any size by \ref Vector_ReaderRead, so a file can be processed piecewise and
+ * is never materialized twice.
+ *
+ * \sa Vector_ReaderOpen
+ */
+typedef struct {
+  /*! Stream the items are read from, it is set to NULL when the reading ends or fails. */
+  FILE *stream;
+
+  /*! Number of items stored in the stream. */
+  uint64_t length;
+
+  /*! Number of items that were not read yet. */
+  uint64_t remaining;
+
+  /*! Checksum of the items read so far. */
+  Vector_Checksum_t checksum;
+} Vector_Reader_t;
+
+/*! Arena that owns the memory of many short-lived vectors, the memory of all of them is released
+ * at once by \ref Vector_ArenaReset or \ref Vector_ArenaDestroy. Blocks are cut from big chunks,
+ * released small blocks (e.g. \ref Vector_t structures) are kept in free lists of their size class
+ * and reused, and the last allocated block grows in place, so creating, expanding and destroying
+ * vectors in the arena normally does not touch the heap at all. Blocks bigger than a chunk get a
+ * chunk of their own, which is resized and released through the heap right away. The arena is not
+ * thread safe.
+ *
+ * \sa Vector_ArenaCreate, Vector_CreateInArena
+ */
+typedef struct Vector_Arena Vector_Arena_t;
+
+/*! Vector shared by one writer and many lock free readers. Readers take snapshots, i.e. immutable
+ * versions of the vector, and never wait for the writer or see its changes half done. The writer
+ * changes a private copy of the current version and publishes it at once, old versions are
+ * released when no reader holds them any more (epoch based reclamation).
+ *
+ * \sa Vector_SharedCreate, Vector_Snapshot, Vector_SharedBeginWrite
+ */
+typedef struct Vector_Shared Vector_Shared_t;
+
+/*! Hash index of the items of a vector that maps a value to the position of its first occurrence,
+ * the structure is private.
+ *
+ * \sa Vector_BuildIndex
+ */
+typedef struct Vector_Index Vector_Index_t;
+
+#ifndef VECTOR_INLINE_CAPACITY
+  /*! Number of items stored directly in the \ref Vector_t structure, 0 disables the inline
+   * storage. The value changes the layout of \ref Vector_t, so the library and all its users must
+   * be built with the same value (the CMake cache variable of the same name takes care of it).
+   */
+  #define VECTOR_INLINE_CAPACITY 0
+#endif
+
 /*! Structure that describes the vector. */
 typedef struct {
   /*! Internal pointer to allocated memory. */
@@ -43,8 +226,76 @@ typedef struct {
 
   /*! Number of cells allocated during expanding. */
   size_t alloc_step;
+
+  /*! Strategy used when the vector runs out of allocated cells. */
+  Vector_GrowthPolicy_t growth_policy;
+
+  /*! Multiplier of the capacity used by the geometric growth. */
+  double growth_factor;
+
+  /*! Capacity from which the hybrid growth switches from \ref Vector_t.alloc_step to \ref
+   * Vector_t.growth_factor. */
+  size_t growth_threshold;
+
+  /*! Conservative flag of sorted items: when it is true, the items are sorted in ascending order,
+   * when it is false, they may be sorted or not. Functions of this module clear it when a write may
+   * break the order (at the cost of a few comparisons per modification) and never set it back, only
+   * \ref Vector_Sort and emptying the vector do. It is valid as long as \ref Vector_t.items are
+   * modified only through this module. Searching functions use binary search when it is set.
+   */
+  bool sorted;
+
+  /*! Allocator of the vector structure and \ref Vector_t.items, it must outlive the vector. */
+  const Vector_Allocator_t *allocator;
+
+  /*! Optional hash index of the items, NULL when the vector has none (see \ref Vector_BuildIndex).
+   * Like \ref Vector_t.sorted it is kept up to date only by the functions of this module.
+   */
+  Vector_Index_t *index;
+
+#if VECTOR_INLINE_CAPACITY > 0
+  /*! Storage of up to \ref VECTOR_INLINE_CAPACITY items. \ref Vector_t.items points here until
+   * the vector needs more cells and spills to the heap, it is moved back when the vector shrinks.
+   * Tiny vectors thus cost a single allocation and no pointer chasing. The structure must not be
+   * copied by value while it is in use.
+   */
+  Vector_DataType_t inline_items[VECTOR_INLINE_CAPACITY];
+#endif
 } Vector_t;
 
+/*! Snapshot of a shared vector held by a reader, see \ref Vector_Snapshot. */
+typedef struct {
+  /*! Version of the vector, it does not change until the snapshot is released. */
+  const Vector_t *vector;
+
+  /*! Shared vector the snapshot was taken from. */
+  Vector_Shared_t *shared;
+
+  /*! Reader slot occupied by the snapshot. */
+  size_t slot;
+} Vector_Snapshot_t;
+
+/*! Read only view of a contiguous range of vector items, see \ref Vector_GetSpan. A span does not
+ * own the items, so hot loops can read \ref Vector_Span_t.data directly and subranges are processed
+ * without copying. It is valid until the items of the vector are reallocated or the vector is
+ * destroyed.
+ */
+typedef struct {
+  /*! First item of the range, it may be NULL when the span is empty. */
+  const Vector_DataType_t *data;
+
+  /*! Number of items of the range. */
+  size_t length;
+
+  /*! The items are sorted in ascending order, it is taken from \ref Vector_t.sorted. */
+  bool sorted;
+} Vector_Span_t;
+
+/*! Predicate that decides about an item of the vector, e.g. whether it should be removed by \ref
+ * Vector_RemoveIf. The \a context is the pointer passed by the caller together with the predicate.
+ */
+typedef bool (*Vector_Predicate_t)(Vector_DataType_t value, void *context);
+
 /* Exported macros -------------------------------------------------------------------------------*/
 /*! Symbol that can be used when reading data from user that can be stored in vector.
  *  \note It must be updated when \ref Vector_DataType_t is changed!
@@ -56,12 +307,53 @@ typedef struct {
  */
 #define VECTOR_DATATYPE_PRINT PRIu64
 
+/*! Minimal length of a vector that is sorted by radix sort, shorter vectors are sorted by
+ * introsort.
+ */
+#define VECTOR_SORT_RADIX_MIN 256
+
+#ifndef VECTOR_MERGE_PARALLEL_MIN
+  /*! Minimal number of items merged by one thread of \ref Vector_MergeParallel. */
+  #define VECTOR_MERGE_PARALLEL_MIN 65536
+#endif
+
+#ifndef VECTOR_PARALLEL_MIN
+  /*! Minimal number of items processed by the thread pool (\ref Vector_ParallelFill, \ref
+   * Vector_ParallelCopy, \ref Vector_Reduce, \ref Vector_CountIf), shorter ranges are processed
+   * serially by the calling thread because waking the pool would cost more than it saves.
+   */
+  #define VECTOR_PARALLEL_MIN 65536
+#endif
+
+#ifndef VECTOR_POOL_THREADS
+  /*! Number of threads of the pool including the calling one, 0 uses one thread per online CPU. */
+  #define VECTOR_POOL_THREADS 0
+#endif
+
+#ifndef VECTOR_SHARED_READERS
+  /*! Maximal number of snapshots of one \ref Vector_Shared_t held at the same time. */
+  #define VECTOR_SHARED_READERS 64
+#endif
+
+/*! Default size of the chunks of memory allocated by \ref Vector_Arena_t. */
+#define VECTOR_ARENA_CHUNK_SIZE 65536
+
+/*! Capacity multiplier that is suitable for most of the \ref VECTOR_GROWTH_GEOMETRIC and \ref
+ * VECTOR_GROWTH_HYBRID vectors. */
+#define VECTOR_GROWTH_DEFAULT_FACTOR 2.0
+
 /* Exported variables ----------------------------------------------------------------------------*/
+/*! Allocator used by vectors that are not created with an explicit one, it is backed by the
+ * myMalloc library. */
+extern const Vector_Allocator_t Vector_DefaultAllocator;
+
 /* Exported functions declarations ---------------------------------------------------------------*/
 /*! Creates a vector with \a initial_size and a \a alloc_step. The returned pointer points to the
  * heap where is allocated new instance of the \ref Vector_t structure. After return from the
  * function the owner of a pointer to a vector structure is the user instead of the library and user
- * is responsible for freeing the memory.
+ * is responsible for freeing the memory. When \a initial_size is not greater than \ref
+ * VECTOR_INLINE_CAPACITY, the items are stored inline and the capacity is \ref
+ * VECTOR_INLINE_CAPACITY.
  *
  * \param[in]   initial_size    Initial items count of the vector.
  * \param[in]   alloc_step      Number of items that are allocated to the vector when run out of
@@ -73,6 +365,39 @@ typedef struct {
  */
 Vector_t *Vector_Create(size_t initial_size, size_t alloc_step);
 
+/*! Creates a vector with \a initial_size whose expansion follows the \a growth configuration.
+ * Ownership of the returned vector is the same as in case of \ref Vector_Create, which is
+ * equivalent to this function with \ref VECTOR_GROWTH_FIXED policy.
+ *
+ * \param[in]   initial_size    Initial items count of the vector.
+ * \param[in]   growth          Growth configuration, it is copied into the vector.
+ *
+ * \return  Pointer to the allocated vector structure or NULL in case of failure or invalid \a
+ * growth configuration.
+ *
+ * \sa Vector_Create, Vector_Destroy
+ */
+Vector_t *Vector_CreateWithGrowth(size_t initial_size, const Vector_Growth_t *const growth);
+
+/*! Creates a vector like \ref Vector_CreateWithGrowth does, but the vector structure and its items
+ * are managed by the \a allocator. Vectors created by \ref Vector_Copy from this vector use the
+ * same \a allocator.
+ *
+ * \param[in]   initial_size    Initial items count of the vector.
+ * \param[in]   growth          Growth configuration, it is copied into the vector.
+ * \param[in]   allocator       Allocator of the vector, only the pointer is stored, so it must
+ * outlive the vector.
+ *
+ * \return  Pointer to the allocated vector structure or NULL in case of failure, invalid \a growth
+ * configuration, NULL \a allocator or an \a allocator that cannot allocate new blocks (see \ref
+ * Vector_Allocator_t.alloc).
+ *
+ * \sa Vector_DefaultAllocator, Vector_CountingAllocatorInit
+ */
+Vector_t *Vector_CreateWithAllocator(size_t initial_size,
+                                     const Vector_Growth_t *const growth,
+                                     const Vector_Allocator_t *const allocator);
+
 /*! Creates a separate (independent) copy of a vector that contains the same data. The returned
  * instance contains only the inserted items to the original vector.
  *
@@ -100,6 +425,50 @@ void Vector_Clear(Vector_t *const vector);
  */
 size_t Vector_Length(const Vector_t *const vector);
 
+/*! Returns the number of cells currently allocated for a vector, i.e. how many items it can hold
+ * before it is expanded.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ *
+ * \return  Current capacity of a vector or SIZE_MAX if vector is NULL.
+ */
+size_t Vector_Capacity(const Vector_t *const vector);
+
+/*! Makes sure that the \a vector can hold at least \a capacity items without further expansion.
+ * The memory is reallocated to exactly \a capacity cells when the current capacity is smaller,
+ * otherwise nothing is done.
+ *
+ * \param[in]   vector      Pointer to a vector.
+ * \param[in]   capacity    Requested minimal capacity.
+ *
+ * \return Returns true when the vector can hold \a capacity items. When the reallocation fails,
+ * false is returned and the vector is not modified.
+ */
+bool Vector_Reserve(Vector_t *const vector, size_t capacity);
+
+/*! Releases unused cells so that the capacity of the \a vector equals to its length. An empty
+ * vector releases its \ref Vector_t.items in the same way as \ref Vector_Clear does.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ *
+ * \return Returns true when the unused memory was released (or there was none). When the
+ * reallocation fails, false is returned and the vector is not modified.
+ */
+bool Vector_ShrinkToFit(Vector_t *const vector);
+
+/*! Changes the length of the \a vector to \a length items. Items behind the new length are
+ * discarded without releasing memory, new items are set to \a value. The vector is expanded at most
+ * once according to its growth policy.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ * \param[in]   length  New length of the vector.
+ * \param[in]   value   Value of the items added behind the current length.
+ *
+ * \return Returns true on success. When the expansion fails, false is returned and the vector is
+ * not modified.
+ */
+bool Vector_Resize(Vector_t *const vector, size_t length, Vector_DataType_t value);
+
 /*! Returns the value of stored item at selected \a position in the \a vector.
  *
  * \param[in]   vector      Pointer to a vector.
@@ -124,8 +493,57 @@ bool Vector_At(const Vector_t *const vector, size_t position, Vector_DataType_t
  */
 bool Vector_Remove(Vector_t *const vector, size_t position);
 
+/*! Removes items from the \a start_position to the \a end_position (including it) and shifts the
+ * rest of the data to the left as a single block. If the \a end_position is located out of \a
+ * vector boundaries, items are removed up to the last item of the \a vector.
+ *
+ * \param[in]   vector          Pointer to a vector.
+ * \param[in]   start_position  Position of the first removed item.
+ * \param[in]   end_position    Position of the last removed item.
+ *
+ * \return Returns true when valid \a vector is passed, \a start_position is within the vector and
+ * it is not behind the \a end_position, otherwise returns false.
+ */
+bool Vector_RemoveRange(Vector_t *const vector, size_t start_position, size_t end_position);
+
+/*! Removes all items for which the \a predicate returns true. The remaining items keep their
+ * order and the vector is compacted in a single pass.
+ *
+ * \param[in]   vector      Pointer to a vector.
+ * \param[in]   predicate   Predicate called once for each item in the order of positions.
+ * \param[in]   context     Pointer passed to each call of the \a predicate.
+ *
+ * \return Returns number of removed items, 0 is returned if \a vector or \a predicate is NULL.
+ */
+size_t Vector_RemoveIf(Vector_t *const vector, Vector_Predicate_t predicate, void *context);
+
+/*! Removes items at the \a positions and compacts the vector in a single pass. The \a positions
+ * must be sorted in ascending order, repeated positions are removed only once and positions
+ * behind the last item are ignored.
+ *
+ * \param[in]   vector      Pointer to a vector.
+ * \param[in]   positions   Sorted array of positions to be removed.
+ * \param[in]   count       Number of items in the \a positions array.
+ *
+ * \return Returns number of removed items. If the \a positions are not sorted, nothing is removed
+ * and 0 is returned.
+ */
+size_t Vector_RemoveIndices(Vector_t *const vector, const size_t *const positions, size_t count);
+
+/*! Removes an item at desired \a position in constant time by moving the last item to its place.
+ * The order of the items is not preserved.
+ *
+ * \param[in]   vector      Pointer to a vector.
+ * \param[in]   position    Position within the vector to be removed.
+ *
+ * \return Returns true when valid \a vector and valid \a position is passed,
+ * otherwise returns false.
+ */
+bool Vector_SwapRemove(Vector_t *const vector, size_t position);
+
 /*! Appends a new item to the end of a vector. If \ref Vector_t.items is full, the memory is
- * reallocated to new size that is computed from current size and \ref Vector_t.alloc_step.
+ * reallocated to new size that is computed from current size according to \ref
+ * Vector_t.growth_policy.
  *
  * \param[in]   vector  Pointer to a vector.
  * \param[in]   value   Value to be inserted.
@@ -134,6 +552,48 @@ bool Vector_Remove(Vector_t *const vector, size_t position);
  */
 size_t Vector_Append(Vector_t *const vector, Vector_DataType_t value);
 
+/*! Appends \a count items from the \a values array to the end of a vector. The memory is expanded
+ * at most once and the items are copied as a single block.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ * \param[in]   values  Array of values to be inserted, it must not point into the \a vector.
+ * \param[in]   count   Number of items in the \a values array.
+ *
+ * \return Returns index of the first inserted item (the length of the vector when \a count is 0).
+ * If append fails it returns SIZE_MAX and the vector is not modified.
+ */
+size_t Vector_AppendArray(Vector_t *const vector,
+                          const Vector_DataType_t *const values,
+                          size_t count);
+
+/*! Appends all items of the \a source vector to the end of the \a vector. The \a source may be the
+ * same vector as the \a vector.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ * \param[in]   source  Pointer to a vector whose items are appended.
+ *
+ * \return Returns index of the first inserted item. If append fails it returns SIZE_MAX and the
+ * vector is not modified.
+ */
+size_t Vector_AppendVector(Vector_t *const vector, const Vector_t *const source);
+
+/*! Inserts \a count items from the \a values array before the item at \a position. Items from the
+ * \a position to the end of the vector are shifted to the right as a single block. The \a position
+ * equal to the length of the vector appends the items.
+ *
+ * \param[in]   vector      Pointer to a vector.
+ * \param[in]   position    Position of the first inserted item.
+ * \param[in]   values      Array of values to be inserted, it must not point into the \a vector.
+ * \param[in]   count       Number of items in the \a values array.
+ *
+ * \return Returns true when valid \a vector and valid \a position is passed and memory for the
+ * items was allocated, otherwise returns false and the vector is not modified.
+ */
+bool Vector_InsertRange(Vector_t *const vector,
+                        size_t position,
+                        const Vector_DataType_t *const values,
+                        size_t count);
+
 /*! Sets \a value in the \a vector at specified \a position. The \a value is applied only if \a
  * position is smaller then current length of the \a vector, otherwise nothing is done.
  *
@@ -143,7 +603,9 @@ size_t Vector_Append(Vector_t *const vector, Vector_DataType_t value);
  */
 void Vector_Set(Vector_t *const vector, size_t position, Vector_DataType_t value);
 
-/*! Looks for the \a value in the \a vector.
+/*! Looks for the \a value in the \a vector. A vector with an index (see \ref Vector_BuildIndex) is
+ * searched by the index, a sorted vector by binary search, otherwise the items are compared several
+ * at once using the widest SIMD instruction set available on the CPU.
  *
  * \param[in]   vector  Pointer to a vector.
  * \param[in]   value   Value to be found.
@@ -154,7 +616,10 @@ void Vector_Set(Vector_t *const vector, size_t position, Vector_DataType_t value
 bool Vector_Contains(const Vector_t *const vector, Vector_DataType_t value);
 
 /*! Finds the position of a \a value in the \a vector. An argument \a from specifies the search
- * offset from where is the value searched.
+ * offset from where is the value searched. The index of the vector (see \ref Vector_BuildIndex)
+ * answers in O(1) unless the first occurrence lies before \a from. Otherwise a sorted vector is
+ * searched by binary search and the items of an unsorted one are compared several at once using the
+ * widest SIMD instruction set available on the CPU.
  *
  * \param[in]   vector  Pointer to a vector.
  * \param[in]   value   Value to be found.
@@ -165,18 +630,153 @@ bool Vector_Contains(const Vector_t *const vector, Vector_DataType_t value);
  */
 size_t Vector_IndexOf(const Vector_t *const vector, Vector_DataType_t value, size_t from);
 
+/*! Finds the position of the last occurrence of a \a value in the \a vector. The search goes
+ * backwards and starts at the position \a from (including it), a \a from behind the last item
+ * searches the whole vector.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ * \param[in]   value   Value to be found.
+ * \param[in]   from    Starting position for backward searching.
+ *
+ * \return  Returns index of position when \a value is found in the \a vector data, otherwise it
+ * returns SIZE_MAX.
+ */
+size_t Vector_LastIndexOf(const Vector_t *const vector, Vector_DataType_t value, size_t from);
+
+/*! Counts the occurrences of a \a value in the \a vector.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ * \param[in]   value   Value to be counted.
+ *
+ * \return  Returns number of items equal to the \a value, 0 is returned if vector is NULL.
+ */
+size_t Vector_CountOf(const Vector_t *const vector, Vector_DataType_t value);
+
+/*! Attaches a hash index to the \a vector, so \ref Vector_Contains and \ref Vector_IndexOf take
+ * O(1) expected time on unsorted vectors. The index is an open addressing table with Robin Hood
+ * probing that maps a value to the position of its first occurrence. Each slot takes 16 bytes and
+ * at most 7/8 of the slots are used, i.e. the index costs 18 to 37 bytes per item on top of the 8
+ * bytes of the item.
+ *
+ * The index is kept up to date by the writes: appended items are added, \ref Vector_Set and \ref
+ * Vector_SwapRemove update the entries of the old and the new value in place and shrinking by \ref
+ * Vector_Resize deletes the entries of the removed items. Writes that take O(n) time anyway (\ref
+ * Vector_Fill, insertions, removals, sorting, ...) rebuild it. Lookups never modify the index, so
+ * an unmodified vector can be searched by several threads at once, e.g. through \ref
+ * Vector_Snapshot. When the index cannot be allocated, lookups search the items directly until a
+ * later write rebuilds it.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ * \param[in]   lazy    When set, the items are indexed by the next modification of the vector (or
+ * by \ref Vector_SharedPublish) instead of now, lookups search the items directly until then.
+ *
+ * \return  True on success, false if the \a vector is NULL or memory allocation fails, the vector
+ * then has no index. Calling the function on a vector that has an index just rebuilds it.
+ */
+bool Vector_BuildIndex(Vector_t *const vector, bool lazy);
+
+/*! Releases the index of the \a vector, nothing is done if it has none. */
+void Vector_DropIndex(Vector_t *const vector);
+
+/*! Returns the number of bytes allocated by the index of the \a vector, 0 if it has none. */
+size_t Vector_IndexMemorySize(const Vector_t *const vector);
+
+/*! Tells whether the items of the \a vector are sorted in ascending order, see \ref
+ * Vector_t.sorted.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ *
+ * \return Returns true if valid \a vector is passed and its items are sorted, false otherwise.
+ */
+bool Vector_IsSorted(const Vector_t *const vector);
+
+/*! Sorts the items of the \a vector in ascending order and sets \ref Vector_t.sorted. Nothing is
+ * done when the vector is already sorted. Vectors with at least \ref VECTOR_SORT_RADIX_MIN items
+ * are sorted by LSD radix sort in linear time using a temporary buffer of the same length, smaller
+ * vectors (or when the buffer cannot be allocated) are sorted in place by introsort.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ *
+ * \return Returns true when the vector was sorted, false otherwise.
+ *
+ * \sa Vector_SortWithScratch
+ */
+bool Vector_Sort(Vector_t *const vector);
+
+/*! Sorts the items of the \a vector in the same way as \ref Vector_Sort does, but the radix sort
+ * uses \ref Vector_t.items of the \a scratch vector as its temporary buffer. The \a scratch is
+ * reserved to the length of the \a vector when needed and its items are discarded, so the same
+ * scratch vector can be reused for many sorts without repeated allocations.
+ *
+ * \param[in]       vector  Pointer to a vector.
+ * \param[in,out]   scratch Pointer to a vector that provides the temporary buffer.
+ *
+ * \return Returns true when the vector was sorted, false otherwise.
+ */
+bool Vector_SortWithScratch(Vector_t *const vector, Vector_t *const scratch);
+
+/*! Inserts a \a value into a sorted \a vector so that it stays sorted. The \a value is inserted
+ * behind the items that are equal to it.
+ *
+ * \param[in]   vector  Pointer to a sorted vector.
+ * \param[in]   value   Value to be inserted.
+ *
+ * \return Returns index of the inserted item. If the \a vector is not sorted or the insertion
+ * fails, it returns SIZE_MAX.
+ */
+size_t Vector_InsertSorted(Vector_t *const vector, Vector_DataType_t value);
+
+/*! Finds the first position in a sorted \a vector whose item is not less than \a value.
+ *
+ * \param[in]   vector  Pointer to a sorted vector.
+ * \param[in]   value   Value to be found.
+ *
+ * \return Returns the position, the length of the vector is returned when all items are less than
+ * \a value. SIZE_MAX is returned if the \a vector is NULL or it is not sorted.
+ */
+size_t Vector_LowerBound(const Vector_t *const vector, Vector_DataType_t value);
+
+/*! Finds the first position in a sorted \a vector whose item is greater than \a value.
+ *
+ * \param[in]   vector  Pointer to a sorted vector.
+ * \param[in]   value   Value to be found.
+ *
+ * \return Returns the position, the length of the vector is returned when no item is greater than
+ * \a value. SIZE_MAX is returned if the \a vector is NULL or it is not sorted.
+ */
+size_t Vector_UpperBound(const Vector_t *const vector, Vector_DataType_t value);
+
+/*! Finds the range of items equal to \a value in a sorted \a vector. The range starts at \a first
+ * and ends before \a last, it is empty when the \a value is not contained.
+ *
+ * \param[in]   vector  Pointer to a sorted vector.
+ * \param[in]   value   Value to be found.
+ * \param[out]  first   Position of the first equal item (\ref Vector_LowerBound).
+ * \param[out]  last    Position behind the last equal item (\ref Vector_UpperBound).
+ *
+ * \return Returns true when valid sorted \a vector and valid output pointers are passed, otherwise
+ * returns false.
+ */
+bool Vector_EqualRange(const Vector_t *const vector,
+                       Vector_DataType_t value,
+                       size_t *const first,
+                       size_t *const last);
+
 /*! Fills a portion of \a vector specified by a range with a desired value. Vector is overwritten
  * from the \a start_position to the \a end_position (including it). If the \a end_position is
  * located out of \a vector boundaries, \a vector is filled from the \a start_position to the last
  * item of the \a vector. If the \a start_position is located behind the last item of a vector, no
  * changes are made.
  *
+ * \note    The \a vector is not const any more, since filling updates \ref Vector_t.sorted. Code
+ * that passed a pointer to a const vector must pass a mutable one now.
+ *
  * \param[in]   vector          Pointer to a vector.
  * \param[in]   value           Value to be set.
  * \param[in]   start_position  Starting position.
  * \param[in]   end_position    End position.
  */
-void Vector_Fill(const Vector_t *const vector,
+void Vector_Fill(Vector_t *const vector,
                  Vector_DataType_t value,
                  size_t start_position,
                  size_t end_position);
@@ -191,8 +791,404 @@ void Vector_Destroy(Vector_t **const vector);
 /*! \} */
 
 /*! Merges two provided SORTED vectors into the \a result vector so that
- *  it is still sorted.
+ *  it is still sorted. Memory of the \a result is expanded only once, the \a result is not
+ *  modified when the expansion fails.
  */
 void Merge(Vector_t * result, Vector_t * v1, Vector_t * v2);
 
+/*! Returns the span of all items of the \a vector, an empty span is returned for NULL \a vector.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ *
+ * \return  Span whose \ref Vector_Span_t.data and \ref Vector_Span_t.length describe the items.
+ */
+Vector_Span_t Vector_GetSpan(const Vector_t *const vector);
+
+/*! Returns the part of the \a span of \a count items from the \a start position. The range is
+ * cropped to the \a span, a slice of a sorted span is sorted as well.
+ *
+ * \param[in]   span    Span to be sliced.
+ * \param[in]   start   Position of the first item of the slice.
+ * \param[in]   count   Number of items of the slice.
+ *
+ * \return  The slice, it is empty when the \a start is behind the end of the \a span.
+ */
+Vector_Span_t Vector_SpanSlice(Vector_Span_t span, size_t start, size_t count);
+
+/*! Finds the position of a \a value in the \a span from the position \a from in the same way as
+ * \ref Vector_IndexOf does, i.e. by binary search when the span is sorted and by the SIMD kernels
+ * otherwise.
+ *
+ * \return  Position within the \a span or SIZE_MAX when the \a value is not found.
+ */
+size_t Vector_SpanIndexOf(Vector_Span_t span, Vector_DataType_t value, size_t from);
+
+/*! Returns true if the \a span contains the \a value, see \ref Vector_SpanIndexOf. */
+bool Vector_SpanContains(Vector_Span_t span, Vector_DataType_t value);
+
+/*! Merges two SORTED spans and appends the items to the \a result vector in the same way as \ref
+ * Merge does. The spans may be slices of any vectors except the \a result, whose items can be
+ * moved by the expansion.
+ *
+ * \param[in,out]   result  Pointer to a vector the merged items are appended to.
+ * \param[in]       a       The first sorted span.
+ * \param[in]       b       The second sorted span.
+ *
+ * \return Returns true on success, false when the \a result is NULL or its expansion fails, the
+ * \a result is not modified then.
+ */
+bool Vector_SpanMerge(Vector_t *const result, Vector_Span_t a, Vector_Span_t b);
+
+/*! Merges \a k SORTED vectors into the \a result vector so that it is still sorted. The inputs are
+ * merged in a single pass by a tournament (loser) tree, i.e. with log2(k) comparisons per item, and
+ * memory of the \a result is expanded only once. Equal items are taken from the inputs in the
+ * order of the \a inputs array.
+ *
+ * \param[in,out]   result  Pointer to a vector the merged items are appended to, it may be one of
+ * the \a inputs.
+ * \param[in]       inputs  Array of pointers to the merged vectors.
+ * \param[in]       k       Number of vectors in the \a inputs array.
+ * \param[in]       dedup   When set, items equal to the previously merged item are skipped.
+ *
+ * \return Returns true on success. False is returned and the \a result is not modified when an
+ * argument is NULL, \a k is too large for the merge tree to be allocated, any of the inputs is not
+ * sorted (see \ref Vector_t.sorted) or memory allocation fails.
+ */
+bool Vector_MergeK(Vector_t *const result, Vector_t *const *const inputs, size_t k, bool dedup);
+
+/*! Merges two SORTED vectors into the \a result vector using up to \a threads threads. The output
+ * is split into equal slices and the start of each slice in both inputs is found by binary search
+ * (co-ranking), so every thread merges its slice directly into a disjoint part of \ref
+ * Vector_t.items of the \a result. Each thread gets at least \ref VECTOR_MERGE_PARALLEL_MIN items,
+ * the calling thread merges the first slice. The output is the same as of \ref Merge.
+ *
+ * \param[in,out]   result  Pointer to a vector the merged items are appended to, it may be one of
+ * the inputs.
+ * \param[in]       v1      Pointer to the first sorted vector.
+ * \param[in]       v2      Pointer to the second sorted vector.
+ * \param[in]       threads Maximal number of threads, values 0 and 1 merge in the calling thread.
+ *
+ * \return Returns true on success. False is returned and the \a result is not modified when an
+ * argument is NULL, any of the inputs is not sorted (see \ref Vector_t.sorted) or memory allocation
+ * fails.
+ */
+bool Vector_MergeParallel(Vector_t *const result,
+                          const Vector_t *const v1,
+                          const Vector_t *const v2,
+                          size_t threads);
+
+/*! Appends the union of two SORTED vectors to the \a result vector. The inputs are treated as
+ * multisets: an item contained m times in \a a and n times in \a b is contained max(m, n) times in
+ * the union. When one input is much shorter than the other, the longer one is walked by galloping
+ * (exponential) search and copied in blocks. The \a result is expanded only once and it may be one
+ * of the inputs.
+ *
+ * \param[in,out]   result  Pointer to a vector the output is appended to.
+ * \param[in]       a       Pointer to the first sorted vector.
+ * \param[in]       b       Pointer to the second sorted vector.
+ *
+ * \return Returns true on success. False is returned and the \a result is not modified when an
+ * argument is NULL, any of the inputs is not sorted (see \ref Vector_t.sorted) or memory allocation
+ * fails.
+ */
+bool Vector_Union(Vector_t *const result, const Vector_t *const a, const Vector_t *const b);
+
+/*! Appends the intersection of two SORTED vectors to the \a result vector, an item is contained
+ * min(m, n) times in it. Otherwise the function works in the same way as \ref Vector_Union.
+ */
+bool Vector_Intersect(Vector_t *const result, const Vector_t *const a, const Vector_t *const b);
+
+/*! Appends the items of SORTED vector \a a that are not in SORTED vector \a b to the \a result
+ * vector, an item is contained max(m - n, 0) times in it. Otherwise the function works in the same
+ * way as \ref Vector_Union.
+ */
+bool Vector_Difference(Vector_t *const result, const Vector_t *const a, const Vector_t *const b);
+
+/*! Appends the items of two SORTED vectors that are contained in just one of them to the \a result
+ * vector, an item is contained |m - n| times in it. Otherwise the function works in the same way as
+ * \ref Vector_Union.
+ */
+bool Vector_SymmetricDifference(Vector_t *const result,
+                                const Vector_t *const a,
+                                const Vector_t *const b);
+
+/*! Fills a portion of the \a vector like \ref Vector_Fill does, but the range is split into chunks
+ * that are filled by the threads of the pool. Chunk boundaries are aligned to cache lines, so no
+ * two threads write to the same line. Ranges shorter than \ref VECTOR_PARALLEL_MIN are filled by
+ * the calling thread.
+ *
+ * \param[in]   vector          Pointer to a vector.
+ * \param[in]   value           Value to be set.
+ * \param[in]   start_position  Starting position.
+ * \param[in]   end_position    End position (including it).
+ */
+void Vector_ParallelFill(Vector_t *const vector,
+                         Vector_DataType_t value,
+                         size_t start_position,
+                         size_t end_position);
+
+/*! Creates a copy of a vector like \ref Vector_Copy does, but the items are copied in chunks by
+ * the threads of the pool, see \ref Vector_ParallelFill.
+ *
+ * \param[in]   original    Pointer to the vector to be copied.
+ *
+ * \return  Returns pointer to the copied vector, NULL is returned in case of failure.
+ */
+Vector_t *Vector_ParallelCopy(const Vector_t *const original);
+
+/*! Combines all items of the \a vector by the operation \a op. Each thread of the pool reduces its
+ * chunks and the partial results are combined by the calling thread.
+ *
+ * \param[in]   vector  Pointer to a vector.
+ * \param[in]   op      Operation, see \ref Vector_ReduceOp_t.
+ * \param[out]  result  The combined value, the sum of an empty vector is 0.
+ *
+ * \return  True on success, false if an argument is NULL, the \a op is unknown or the minimum or
+ * maximum of an empty vector is requested.
+ */
+bool Vector_Reduce(const Vector_t *const vector,
+                   Vector_ReduceOp_t op,
+                   Vector_DataType_t *const result);
+
+/*! Counts items of the \a vector the \a predicate holds for, the items are tested by the threads of
+ * the pool in parallel, so the \a predicate must be thread safe. The \a predicate may call the
+ * parallel operations (\ref Vector_ParallelFill, \ref Vector_Reduce, ...), which then run serially
+ * in the thread that calls the \a predicate.
+ *
+ * \return  Number of the items, 0 is returned if an argument is NULL.
+ */
+size_t Vector_CountIf(const Vector_t *const vector, Vector_Predicate_t predicate, void *context);
+
+/*! Initializes the \a counting allocator, whose \ref Vector_CountingAllocator_t.allocator can
+ * then be passed to \ref Vector_CreateWithAllocator. All statistics are set to zero.
+ *
+ * \param[out]  counting    Allocator to be initialized.
+ * \param[in]   backend     Allocator that manages the memory, \ref Vector_DefaultAllocator is used
+ * when it is NULL.
+ */
+void Vector_CountingAllocatorInit(Vector_CountingAllocator_t *const counting,
+                                  const Vector_Allocator_t *const backend);
+
+/*! Sets all statistics of the \a counting allocator but \ref Vector_AllocStats_t.live_bytes to
+ * zero, the \ref Vector_AllocStats_t.peak_bytes is set to the current live bytes, so the activity
+ * of a single workload can be measured.
+ *
+ * \param[in,out]   counting    Allocator whose statistics are reset.
+ */
+void Vector_CountingAllocatorReset(Vector_CountingAllocator_t *const counting);
+
+/*! Creates an empty arena. No memory besides the arena structure is allocated until the first
+ * vector is created in it.
+ *
+ * \param[in]   chunk_size  Size of the chunks of memory the arena allocates from the heap, \ref
+ * VECTOR_ARENA_CHUNK_SIZE is used when it is 0. Bigger blocks get a chunk of their own.
+ *
+ * \return  Pointer to the arena or NULL in case of failure.
+ *
+ * \sa Vector_ArenaDestroy
+ */
+Vector_Arena_t *Vector_ArenaCreate(size_t chunk_size);
+
+/*! Creates an empty arena like \ref Vector_ArenaCreate does, but the arena structure and its
+ * chunks are managed by the \a backend allocator instead of the heap.
+ *
+ * \param[in]   chunk_size  Size of the chunks of memory, \ref VECTOR_ARENA_CHUNK_SIZE is used when
+ * it is 0.
+ * \param[in]   backend     Allocator of the chunks, only the pointer is stored, so it must outlive
+ * the arena.
+ *
+ * \return  Pointer to the arena or NULL in case of failure or when the \a backend cannot allocate.
+ *
+ * \sa Vector_CountingAllocatorInit
+ */
+Vector_Arena_t *Vector_ArenaCreateWithAllocator(size_t chunk_size,
+                                                const Vector_Allocator_t *const backend);
+
+/*! Returns the allocator of the \a arena, which can be passed to \ref Vector_CreateWithAllocator,
+ * or NULL when the \a arena is NULL.
+ */
+const Vector_Allocator_t *Vector_ArenaAllocator(Vector_Arena_t *const arena);
+
+/*! Creates a vector like \ref Vector_Create does, but the vector structure and its items are
+ * allocated in the \a arena. The vector may be destroyed by \ref Vector_Destroy, which returns
+ * its memory to the \a arena, or left to be released together with the \a arena.
+ *
+ * \param[in]   arena           Arena the vector is allocated in.
+ * \param[in]   initial_size    Initial items count of the vector.
+ * \param[in]   alloc_step      Number of items that are allocated to the vector when run out of
+ * memory.
+ *
+ * \return  Pointer to the vector or NULL in case of failure.
+ */
+Vector_t *Vector_CreateInArena(Vector_Arena_t *const arena, size_t initial_size, size_t alloc_step);
+
+/*! Releases the memory of all vectors created in the \a arena at once, the vectors must not be used
+ * afterwards. Regular chunks are kept for reuse, so an arena reset after each request allocates
+ * from the heap only while the request size grows.
+ *
+ * \param[in,out]   arena   Arena to be reset.
+ */
+void Vector_ArenaReset(Vector_Arena_t *const arena);
+
+/*! Releases all memory of the \a arena including all vectors created in it, which must not be used
+ * afterwards. Pointer to the \a arena is then set to NULL.
+ *
+ * \param[in,out]   arena   Pointer to an address of the arena.
+ */
+void Vector_ArenaDestroy(Vector_Arena_t **const arena);
+
+/*! Opens a vector stored in the file at the \a path. \ref Vector_t.items point directly into a
+ * memory mapping of the file, so all read operations (\ref Vector_At, \ref Vector_IndexOf, \ref
+ * Merge, ...) work over the file without copying it and the vector may be larger than RAM. The
+ * vector grows geometrically, the file is extended and remapped (by mremap where available). The
+ * file starts by a header with the length of the vector, the items in the native byte order follow.
+ *
+ * The vector is closed by \ref Vector_Destroy, which stores the length and cuts the file to it. The
+ * data reach the file through the page cache, \ref Vector_SyncMapped makes them durable. Copies of
+ * the vector (\ref Vector_Copy) are ordinary heap vectors. Only POSIX systems are supported.
+ *
+ * \param[in]   path    Path to the file.
+ * \param[in]   mode    Access mode.
+ *
+ * \return  Pointer to the vector or NULL when the file cannot be opened or mapped, it is not a
+ * vector file of the same \ref Vector_DataType_t or the platform is not supported.
+ */
+Vector_t *Vector_OpenMapped(const char *path, Vector_MapMode_t mode);
+
+/*! Makes all changes of a mapped \a vector durable: the length is stored to the header and the
+ * mapping and the file are flushed to the disk. A crash after the return loses nothing of the
+ * current state.
+ *
+ * \param[in]   vector  Pointer to a vector opened by \ref Vector_OpenMapped.
+ *
+ * \return  True on success, false if the \a vector is not mapped, is read only or the flush fails.
+ */
+bool Vector_SyncMapped(Vector_t *const vector);
+
+/*! Writes the \a vector to the binary \a stream. The output consists of a versioned header with the
+ * number of items, the items as a single block of little endian values and a checksum of the items.
+ * On little endian hosts the items are written directly from \ref Vector_t.items by one call.
+ *
+ * \param[in]   vector  Pointer to a vector to be saved.
+ * \param[in]   stream  Stream opened for binary writing.
+ *
+ * \return  True on success, false if an argument is NULL or writing fails.
+ *
+ * \sa Vector_Load, Vector_ReaderOpen
+ */
+bool Vector_Save(const Vector_t *const vector, FILE *const stream);
+
+/*! Reads a vector written by \ref Vector_Save from the binary \a stream. The items are read
+ * directly into the vector. It is allocated for all items at once when the stream is seekable and
+ * its size confirms the length from the header, otherwise the items are read in growing chunks, so
+ * a corrupted length never allocates much more memory than the data actually present.
+ *
+ * \param[in]   stream      Stream opened for binary reading.
+ * \param[in]   alloc_step  Number of items that are allocated to the vector when run out of
+ * memory.
+ *
+ * \return  Pointer to the loaded vector or NULL if the stream does not contain a vector of the same
+ * \ref Vector_DataType_t and format version, is truncated, the checksum does not match or memory
+ * allocation fails.
+ */
+Vector_t *Vector_Load(FILE *const stream, size_t alloc_step);
+
+/*! Reads the header of a vector written by \ref Vector_Save and initializes the \a reader. Number
+ * of the stored items is available in \ref Vector_Reader_t.length then.
+ *
+ * \param[out]  reader  Reader to be initialized.
+ * \param[in]   stream  Stream opened for binary reading, it is not closed by the reader.
+ *
+ * \return  True on success, false if an argument is NULL, the header is invalid or a seekable \a
+ * stream is shorter than the stored items.
+ */
+bool Vector_ReaderOpen(Vector_Reader_t *const reader, FILE *const stream);
+
+/*! Appends up to \a max_items next items of the \a reader to the \a vector. The \a vector is
+ * expanded at most once and the items are read directly into it. The checksum is verified when the
+ * last item is read, i.e. items appended by previous calls are verified only by the last call.
+ *
+ * \param[in,out]   reader      Reader initialized by \ref Vector_ReaderOpen.
+ * \param[in,out]   vector      Pointer to a vector the items are appended to.
+ * \param[in]       max_items   Maximal number of appended items.
+ *
+ * \return  Number of appended items, which is 0 only when all items were read (see \ref
+ * Vector_ReaderFinished), or SIZE_MAX if an argument is NULL, \a max_items is 0 while items are
+ * left, reading fails, the checksum does not match or memory allocation fails. Items of the failed
+ * call are not appended.
+ */
+size_t Vector_ReaderRead(Vector_Reader_t *const reader, Vector_t *const vector, size_t max_items);
+
+/*! Tells whether all items of the \a reader were read and their checksum matched.
+ *
+ * \return  True when the \a reader is finished, false if it is NULL, items are left or it failed.
+ */
+bool Vector_ReaderFinished(const Vector_Reader_t *const reader);
+
+/*! Creates a shared vector whose first version is the \a vector, the shared vector takes its
+ * ownership.
+ *
+ * \param[in]   vector  Pointer to a vector, it must not be used directly afterwards.
+ *
+ * \return  Pointer to the shared vector or NULL in case of failure, the \a vector is not taken
+ * then.
+ *
+ * \sa Vector_SharedDestroy
+ */
+Vector_Shared_t *Vector_SharedCreate(Vector_t *const vector);
+
+/*! Takes a snapshot of the current version of the \a shared vector. The reader neither locks nor
+ * waits: it announces the current epoch in a free reader slot and loads the current version. The
+ * version stays valid and unchanged until \ref Vector_SnapshotRelease, so all read functions (\ref
+ * Vector_At, \ref Vector_IndexOf, ...) can be used on it while the writer publishes new versions.
+ *
+ * \param[in]   shared      Pointer to a shared vector.
+ * \param[out]  snapshot    Snapshot to be filled, it must be released by \ref
+ * Vector_SnapshotRelease.
+ *
+ * \return  The version of the vector or NULL if an argument is NULL or all \ref
+ * VECTOR_SHARED_READERS slots are taken.
+ */
+const Vector_t *Vector_Snapshot(Vector_Shared_t *const shared, Vector_Snapshot_t *const snapshot);
+
+/*! Releases the \a snapshot, its version may be reclaimed afterwards. */
+void Vector_SnapshotRelease(Vector_Snapshot_t *const snapshot);
+
+/*! Starts a change of the \a shared vector and returns a private copy of its current version. The
+ * copy may be modified by any function of this module and the changes are visible to readers only
+ * after \ref Vector_SharedPublish. Writers are serialized: the call waits until another write is
+ * published or cancelled, and the write must be finished by the thread that started it.
+ *
+ * \return  The copy to be modified or NULL if the \a shared is NULL or memory allocation fails.
+ */
+Vector_t *Vector_SharedBeginWrite(Vector_Shared_t *const shared);
+
+/*! Makes the copy returned by \ref Vector_SharedBeginWrite the current version by a single atomic
+ * store and retires the previous version. Retired versions that no snapshot can hold any more are
+ * reclaimed, one of them is kept for the next write. An index of the copy (see \ref
+ * Vector_BuildIndex) is brought up to date before, or dropped when it cannot be built.
+ *
+ * \return  True on success, false if no write is in progress or memory allocation fails, the write
+ * stays in progress then.
+ */
+bool Vector_SharedPublish(Vector_Shared_t *const shared);
+
+/*! Discards the copy returned by \ref Vector_SharedBeginWrite and finishes the write, the current
+ * version is not changed.
+ */
+void Vector_SharedCancelWrite(Vector_Shared_t *const shared);
+
+/*! Reclaims retired versions that are not held by any snapshot. It may be called by the writer
+ * after readers released old snapshots, publishing does it too.
+ *
+ * \return  Number of retired versions that are still held by snapshots, or SIZE_MAX if the \a
+ * shared is NULL.
+ */
+size_t Vector_SharedReclaim(Vector_Shared_t *const shared);
+
+/*! Releases the \a shared vector and all its versions, pointer to it is then set to NULL. No
+ * snapshot may be held and no write may be in progress.
+ */
+void Vector_SharedDestroy(Vector_Shared_t **const shared);
+
 #endif  //__VECTOR_H
@@ -0,0 +1,280 @@
+/*!
+ * \file       segmented_vector.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Implementation of segmented_vector.h header file
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "segmented_vector.h"
+#include "vector_kernels.h"
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Mask of the position of an item inside its chunk. */
+#define CHUNK_MASK (SEGMENTED_VECTOR_CHUNK_SIZE - 1)
+
+/*! Number of bytes of one chunk. */
+#define CHUNK_BYTES (SEGMENTED_VECTOR_CHUNK_SIZE * sizeof(Vector_DataType_t))
+
+/*! Smallest number of cells of the chunk directory. */
+#define DIRECTORY_MIN 8
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static bool segmented_add_chunk(SegmentedVector_t *const vector);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+SegmentedVector_t *SegmentedVector_Create(size_t initial_size)
+{
+    return SegmentedVector_CreateWithAllocator(initial_size, &Vector_DefaultAllocator);
+}
+
+SegmentedVector_t *SegmentedVector_CreateWithAllocator(size_t initial_size,
+                                                       const Vector_Allocator_t *const allocator)
+{
+    if(allocator == NULL || allocator->alloc == NULL)
+    {
+        return NULL;
+    }
+
+    SegmentedVector_t *v = allocator->alloc(allocator->context, sizeof(SegmentedVector_t));
+    if(v == NULL)
+    {
+        return NULL;
+    }
+    v->chunks = NULL;
+    v->chunk_count = 0;
+    v->directory_size = 0;
+    v->length = 0;
+    v->allocator = allocator;
+
+    size_t chunkCount = initial_size / SEGMENTED_VECTOR_CHUNK_SIZE
+                        + (initial_size % SEGMENTED_VECTOR_CHUNK_SIZE != 0);
+    for(size_t i = 0; i < chunkCount; i++)
+    {
+        if(!segmented_add_chunk(v))
+        {
+            SegmentedVector_Destroy(&v);
+            return NULL;
+        }
+    }
+    return v;
+}
+
+size_t SegmentedVector_Length(const SegmentedVector_t *const vector)
+{
+    if(vector)
+    {
+        return vector->length;
+    }
+    return SIZE_MAX;
+}
+
+size_t SegmentedVector_Append(SegmentedVector_t *const vector, Vector_DataType_t value)
+{
+    if(vector)
+    {
+        size_t position = vector->length;
+        if((position >> SEGMENTED_VECTOR_CHUNK_BITS) == vector->chunk_count
+           && !segmented_add_chunk(vector))
+        {
+            return SIZE_MAX;
+        }
+        vector->chunks[position >> SEGMENTED_VECTOR_CHUNK_BITS][position & CHUNK_MASK] = value;
+        vector->length++;
+        return position;
+    }
+    return SIZE_MAX;
+}
+
+bool SegmentedVector_At(const SegmentedVector_t *const vector,
+                        size_t position,
+                        Vector_DataType_t *const value)
+{
+    Vector_DataType_t *item = SegmentedVector_ItemAddress(vector, position);
+    if(item && value)
+    {
+        *value = *item;
+        return true;
+    }
+    return false;
+}
+
+Vector_DataType_t *SegmentedVector_ItemAddress(const SegmentedVector_t *const vector,
+                                               size_t position)
+{
+    if(vector && position < vector->length)
+    {
+        return &vector->chunks[position >> SEGMENTED_VECTOR_CHUNK_BITS][position & CHUNK_MASK];
+    }
+    return NULL;
+}
+
+void SegmentedVector_Set(SegmentedVector_t *const vector, size_t position, Vector_DataType_t value)
+{
+    Vector_DataType_t *item = SegmentedVector_ItemAddress(vector, position);
+    if(item)
+    {
+        *item = value;
+    }
+}
+
+void SegmentedVector_Fill(SegmentedVector_t *const vector,
+                          Vector_DataType_t value,
+                          size_t start_position,
+                          size_t end_position)
+{
+    if(vector == NULL || start_position >= vector->length || end_position < start_position)
+    {
+        return;
+    }
+
+    size_t end = end_position < vector->length ? end_position + 1 : vector->length;
+    for(size_t position = start_position; position < end;)
+    {
+        Vector_DataType_t *chunk = vector->chunks[position >> SEGMENTED_VECTOR_CHUNK_BITS];
+        size_t offset = position & CHUNK_MASK;
+        size_t count = SEGMENTED_VECTOR_CHUNK_SIZE - offset;
+        if(count > end - position)
+        {
+            count = end - position;
+        }
+        for(size_t i = 0; i < count; i++)
+        {
+            chunk[offset + i] = value;
+        }
+        position += count;
+    }
+}
+
+size_t SegmentedVector_IndexOf(const SegmentedVector_t *const vector,
+                               Vector_DataType_t value,
+                               size_t from)
+{
+    if(vector == NULL)
+    {
+        return SIZE_MAX;
+    }
+
+    const VectorKernels_t *kernels = vector_kernels_get();
+    for(size_t position = from; position < vector->length;)
+    {
+        const Vector_DataType_t *chunk = vector->chunks[position >> SEGMENTED_VECTOR_CHUNK_BITS];
+        size_t offset = position & CHUNK_MASK;
+        size_t count = SEGMENTED_VECTOR_CHUNK_SIZE - offset;
+        if(count > vector->length - position)
+        {
+            count = vector->length - position;
+        }
+        size_t found = kernels->find_first(chunk + offset, count, value);
+        if(found < count)
+        {
+            return position + found;
+        }
+        position += count;
+    }
+    return SIZE_MAX;
+}
+
+bool SegmentedVector_Contains(const SegmentedVector_t *const vector, Vector_DataType_t value)
+{
+    return SegmentedVector_IndexOf(vector, value, 0) != SIZE_MAX;
+}
+
+bool SegmentedVector_Remove(SegmentedVector_t *const vector, size_t position)
+{
+    if(vector == NULL || position >= vector->length)
+    {
+        return false;
+    }
+
+    // each chunk is shifted by one block move and takes the first item of the next chunk
+    size_t last = vector->length - 1;
+    size_t chunkIndex = position >> SEGMENTED_VECTOR_CHUNK_BITS;
+    size_t lastChunk = last >> SEGMENTED_VECTOR_CHUNK_BITS;
+    size_t offset = position & CHUNK_MASK;
+    for(; chunkIndex <= lastChunk; chunkIndex++, offset = 0)
+    {
+        Vector_DataType_t *chunk = vector->chunks[chunkIndex];
+        size_t end = chunkIndex == lastChunk ? (last & CHUNK_MASK) : CHUNK_MASK;
+        memmove(chunk + offset, chunk + offset + 1, (end - offset) * sizeof(Vector_DataType_t));
+        if(chunkIndex < lastChunk)
+        {
+            chunk[CHUNK_MASK] = vector->chunks[chunkIndex + 1][0];
+        }
+    }
+    vector->length--;
+
+    // keep one unused chunk for the following appends
+    size_t usedChunks = vector->length / SEGMENTED_VECTOR_CHUNK_SIZE
+                        + (vector->length % SEGMENTED_VECTOR_CHUNK_SIZE != 0);
+    while(vector->chunk_count > usedChunks + 1)
+    {
+        vector->chunk_count--;
+        vector->allocator->free(vector->allocator->context,
+                                vector->chunks[vector->chunk_count],
+                                CHUNK_BYTES);
+    }
+    return true;
+}
+
+void SegmentedVector_Destroy(SegmentedVector_t **const vector)
+{
+    if(vector && *vector)
+    {
+        const Vector_Allocator_t *allocator = (*vector)->allocator;
+        for(size_t i = 0; i < (*vector)->chunk_count; i++)
+        {
+            allocator->free(allocator->context, (*vector)->chunks[i], CHUNK_BYTES);
+        }
+        allocator->free(allocator->context,
+                        (*vector)->chunks,
+                        (*vector)->directory_size * sizeof(Vector_DataType_t *));
+        allocator->free(allocator->context, *vector, sizeof(SegmentedVector_t));
+        *vector = NULL;
+    }
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Allocates one more chunk, the directory is doubled when it is full. Only the chunk pointers are
+ * copied by the expansion of the directory, never the items. The \a vector is not modified when an
+ * allocation fails.
+ */
+static bool segmented_add_chunk(SegmentedVector_t *const vector)
+{
+    const Vector_Allocator_t *allocator = vector->allocator;
+    if(vector->chunk_count == vector->directory_size)
+    {
+        size_t directorySize = vector->directory_size ? 2 * vector->directory_size : DIRECTORY_MIN;
+        if(directorySize > SIZE_MAX / sizeof(Vector_DataType_t *))
+        {
+            return false;
+        }
+        Vector_DataType_t **chunks =
+          allocator->realloc(allocator->context,
+                             vector->chunks,
+                             vector->directory_size * sizeof(Vector_DataType_t *),
+                             directorySize * sizeof(Vector_DataType_t *));
+        if(chunks == NULL)
+        {
+            return false;
+        }
+        vector->chunks = chunks;
+        vector->directory_size = directorySize;
+    }
+
+    Vector_DataType_t *chunk = allocator->alloc(allocator->context, CHUNK_BYTES);
+    if(chunk == NULL)
+    {
+        return false;
+    }
+    vector->chunks[vector->chunk_count++] = chunk;
+    return true;
+}
@@ -0,0 +1,19 @@
+/*!
+ * \file       typed_vector.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Instances of the typed vectors provided by the library
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "typed_vector.h"
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+TYPED_VECTOR_DEFINE(VectorU32, uint32_t, uint32_t, UNSIGNED)
+TYPED_VECTOR_DEFINE(VectorI16, int16_t, uint16_t, SIGNED)
+TYPED_VECTOR_DEFINE(VectorF64, double, uint64_t, FLOAT)
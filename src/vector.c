@@ -12,9 +12,11 @@
  */
 /* Includes --------------------------------------------------------------------------------------*/
 #include "vector.h"
-#include <mymalloc.h>
+#include "vector_internal.h"
+#include "vector_kernels.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 /* Private types ---------------------------------------------------------------------------------*/
 /* Private macros --------------------------------------------------------------------------------*/
@@ -22,47 +24,93 @@
 
 /* Private variables -----------------------------------------------------------------------------*/
 /* Private function declarations -----------------------------------------------------------------*/
+static void vector_track_order(Vector_t *const vector, size_t position, size_t count, bool scan);
+static size_t vector_next_capacity(const Vector_t *const vector, size_t required);
+static bool vector_set_capacity(Vector_t *const vector, size_t capacity);
+static void vector_free_items(Vector_t *const vector);
+static void vector_merge_spans(Vector_t *const result, Vector_Span_t a, Vector_Span_t b);
+
 /* Exported functions definitions ----------------------------------------------------------------*/
 Vector_t *Vector_Create(size_t initial_size, size_t alloc_step)
 {
-  Vector_t * v = myMalloc(sizeof(Vector_t));
-  v->items = myMalloc(initial_size * sizeof(Vector_DataType_t));
-  if(v->items == NULL)
-  {
-      myFree(v);
-      return NULL;
-  }
-  v->size = initial_size;
-  v->alloc_step = alloc_step;
-  v->next = v->items;
-  return v;
+    Vector_Growth_t growth = {
+        .policy = VECTOR_GROWTH_FIXED,
+        .alloc_step = alloc_step,
+        .factor = VECTOR_GROWTH_DEFAULT_FACTOR,
+        .threshold = 0,
+    };
+    return Vector_CreateWithGrowth(initial_size, &growth);
 }
 
-Vector_t *Vector_Copy(const Vector_t *const original)
+Vector_t *Vector_CreateWithGrowth(size_t initial_size, const Vector_Growth_t *const growth)
 {
-    if(original)
+    return Vector_CreateWithAllocator(initial_size, growth, &Vector_DefaultAllocator);
+}
+
+Vector_t *Vector_CreateWithAllocator(size_t initial_size,
+                                     const Vector_Growth_t *const growth,
+                                     const Vector_Allocator_t *const allocator)
+{
+    if(growth == NULL || allocator == NULL || allocator->alloc == NULL)
     {
-        Vector_t* v = myMalloc(sizeof(Vector_t));
-        if(v == NULL)
+        return NULL;
+    }
+    if(growth->policy != VECTOR_GROWTH_FIXED && !(growth->factor > 1.0))
+    {
+        return NULL;
+    }
+    if(initial_size > SIZE_MAX / sizeof(Vector_DataType_t))
+    {
+        return NULL;
+    }
+
+    Vector_t * v = allocator->alloc(allocator->context, sizeof(Vector_t));
+    if(v == NULL)
+    {
+        return NULL;
+    }
+#if VECTOR_INLINE_CAPACITY > 0
+    if(initial_size <= VECTOR_INLINE_CAPACITY)
+    {
+        v->items = v->inline_items;
+        initial_size = VECTOR_INLINE_CAPACITY;
+    }
+    else
+#endif
+    {
+        v->items = allocator->alloc(allocator->context, initial_size * sizeof(Vector_DataType_t));
+        if(v->items == NULL)
         {
+            allocator->free(allocator->context, v, sizeof(Vector_t));
             return NULL;
         }
-        v->size = original->size;
-        v->items = myMalloc(original->size * sizeof(Vector_DataType_t));
-        if(v->items == NULL)
+    }
+    vector_init(v, v->items, initial_size, growth, allocator);
+    return v;
+}
+
+Vector_t *Vector_Copy(const Vector_t *const original)
+{
+    if(original)
+    {
+        Vector_Growth_t growth = {
+            .policy = original->growth_policy,
+            .alloc_step = original->alloc_step,
+            .factor = original->growth_factor,
+            .threshold = original->growth_threshold,
+        };
+        Vector_t* v = Vector_CreateWithAllocator(original->size,
+                                                 &growth,
+                                                 vector_derived_allocator(original));
+        if(v == NULL)
         {
-            myFree(v);
             return NULL;
         }
-        v->alloc_step = original->alloc_step;
-        v->next = v->items;
 
-        Vector_DataType_t value;
-        size_t itemCount = Vector_Length(original);
-        for(size_t i = 0; i < itemCount; i++)
+        if(Vector_AppendArray(v, original->items, Vector_Length(original)) == SIZE_MAX)
         {
-            if(Vector_At(original, i, &value))
-            Vector_Append(v, value);
+            Vector_Destroy(&v);
+            return NULL;
         }
 
         return v;
@@ -74,10 +122,14 @@ void Vector_Clear(Vector_t *const vector)
 {
     if(vector)
     {
-        myFree(vector->items);
+        // the items are released as an empty block, so e.g. a mapped file is emptied right away
+        vector->next = vector->items;
+        vector_free_items(vector);
         vector->items = NULL;
         vector->next = NULL;
         vector->size = 0;
+        vector->sorted = true;
+        vector_index_rebuild(vector);
     }
 }
 
@@ -90,6 +142,73 @@ size_t Vector_Length(const Vector_t *const vector)
     return SIZE_MAX;
 }
 
+size_t Vector_Capacity(const Vector_t *const vector)
+{
+    if(vector)
+    {
+        return vector->size;
+    }
+    return SIZE_MAX;
+}
+
+bool Vector_Reserve(Vector_t *const vector, size_t capacity)
+{
+    if(vector)
+    {
+        if(capacity <= vector->size)
+        {
+            return true;
+        }
+        return vector_set_capacity(vector, capacity);
+    }
+    return false;
+}
+
+bool Vector_ShrinkToFit(Vector_t *const vector)
+{
+    if(vector)
+    {
+        size_t itemCount = Vector_Length(vector);
+        if(itemCount == vector->size)
+        {
+            return true;
+        }
+        if(itemCount == 0)
+        {
+            Vector_Clear(vector);
+            return true;
+        }
+        return vector_set_capacity(vector, itemCount);
+    }
+    return false;
+}
+
+bool Vector_Resize(Vector_t *const vector, size_t length, Vector_DataType_t value)
+{
+    if(vector)
+    {
+        size_t itemCount = Vector_Length(vector);
+        if(length > itemCount)
+        {
+            if(!vector_ensure_capacity(vector, length - itemCount))
+            {
+                return false;
+            }
+            for(size_t i = itemCount; i < length; i++)
+            {
+                *(vector->items + i) = value;
+            }
+            vector->next = vector->items + length;
+            vector_track_sorted(vector, itemCount, length - itemCount, false);
+            return true;
+        }
+        vector->next = vector->items + length;
+        vector_index_truncated(vector, itemCount);
+        return true;
+    }
+    return false;
+}
+
 bool Vector_At(const Vector_t *const vector, size_t position, Vector_DataType_t *const value)
 {
     if(vector)
@@ -114,11 +233,133 @@ bool Vector_Remove(Vector_t *const vector, size_t position)
             return false;
         }
 
-        for(size_t i = position; i + 1 < itemCount;i++)
+        memmove(vector->items + position,
+                vector->items + position + 1,
+                (itemCount - position - 1) * sizeof(Vector_DataType_t));
+        vector->next--;
+        vector_index_rebuild(vector);
+        return true;
+    }
+    return false;
+}
+
+bool Vector_RemoveRange(Vector_t *const vector, size_t start_position, size_t end_position)
+{
+    if(vector)
+    {
+        size_t itemCount = Vector_Length(vector);
+        if(start_position >= itemCount || end_position < start_position)
+        {
+            return false;
+        }
+
+        size_t removed = end_position < itemCount ? end_position - start_position + 1
+                                                  : itemCount - start_position;
+        memmove(vector->items + start_position,
+                vector->items + start_position + removed,
+                (itemCount - start_position - removed) * sizeof(Vector_DataType_t));
+        vector->next -= removed;
+        vector_index_rebuild(vector);
+        return true;
+    }
+    return false;
+}
+
+size_t Vector_RemoveIf(Vector_t *const vector, Vector_Predicate_t predicate, void *context)
+{
+    if(vector && predicate)
+    {
+        size_t itemCount = Vector_Length(vector);
+        size_t kept = 0;
+        size_t i = 0;
+        while(i < itemCount)
         {
-            *(vector->items + i) = *(vector->items + i + 1);
+            // move each run of kept items at once
+            size_t runStart = i;
+            while(i < itemCount && !predicate(*(vector->items + i), context))
+            {
+                i++;
+            }
+            if(i > runStart && kept != runStart)
+            {
+                memmove(vector->items + kept,
+                        vector->items + runStart,
+                        (i - runStart) * sizeof(Vector_DataType_t));
+            }
+            kept += i - runStart;
+            i++;
         }
+        vector->next = vector->items + kept;
+        vector_index_rebuild(vector);
+        return itemCount - kept;
+    }
+    return 0;
+}
+
+size_t Vector_RemoveIndices(Vector_t *const vector, const size_t *const positions, size_t count)
+{
+    if(vector && positions)
+    {
+        for(size_t i = 1; i < count; i++)
+        {
+            if(positions[i] < positions[i - 1])
+            {
+                return 0;
+            }
+        }
+
+        size_t itemCount = Vector_Length(vector);
+        size_t kept = 0;
+        size_t runStart = 0;
+        for(size_t i = 0; i < count && positions[i] < itemCount; i++)
+        {
+            size_t position = positions[i];
+            if(position < runStart)
+            {
+                continue;  // repeated position
+            }
+            if(kept != runStart)
+            {
+                memmove(vector->items + kept,
+                        vector->items + runStart,
+                        (position - runStart) * sizeof(Vector_DataType_t));
+            }
+            kept += position - runStart;
+            runStart = position + 1;
+        }
+        if(kept != runStart)
+        {
+            memmove(vector->items + kept,
+                    vector->items + runStart,
+                    (itemCount - runStart) * sizeof(Vector_DataType_t));
+        }
+        kept += itemCount - runStart;
+        vector->next = vector->items + kept;
+        vector_index_rebuild(vector);
+        return itemCount - kept;
+    }
+    return 0;
+}
+
+bool Vector_SwapRemove(Vector_t *const vector, size_t position)
+{
+    if(vector)
+    {
+        size_t itemCount = Vector_Length(vector);
+        if(position >= itemCount)
+        {
+            return false;
+        }
+
+        Vector_DataType_t removed = *(vector->items + position);
+        *(vector->items + position) = *(vector->items + itemCount - 1);
+        vector_index_replaced(vector, position, removed);
         vector->next--;
+        vector_index_truncated(vector, itemCount);
+        if(position + 1 < itemCount)
+        {
+            vector_track_order(vector, position, 1, false);
+        }
         return true;
     }
     return false;
@@ -128,27 +369,94 @@ size_t Vector_Append(Vector_t *vector, Vector_DataType_t value)
 {
     if(vector)
     {
-        if(vector->next >= vector->items + vector->size)
+        if(!vector_ensure_capacity(vector, 1))
         {
-            size_t itemCount = Vector_Length(vector);
-            Vector_DataType_t *temp = myRealloc(vector->items,
-                                              sizeof(Vector_DataType_t)*(vector->size + vector->alloc_step));
-            if(temp == NULL)
-            {
-                return SIZE_MAX;
-            }
-            vector->items = temp;
-            vector->size += vector->alloc_step;
-            vector->next = vector->items + itemCount;
+            return SIZE_MAX;
         }
         *(vector->next) = value;
         size_t appendedAt = vector->next - vector->items;
         vector->next++;
+        vector_track_sorted(vector, appendedAt, 1, false);
         return appendedAt;
     }
     return SIZE_MAX;
 }
 
+size_t Vector_AppendArray(Vector_t *const vector,
+                          const Vector_DataType_t *const values,
+                          size_t count)
+{
+    if(vector && (values || count == 0))
+    {
+        if(!vector_ensure_capacity(vector, count))
+        {
+            return SIZE_MAX;
+        }
+        size_t appendedAt = Vector_Length(vector);
+        if(count > 0)
+        {
+            memcpy(vector->next, values, count * sizeof(Vector_DataType_t));
+            vector->next += count;
+            vector_track_sorted(vector, appendedAt, count, true);
+        }
+        return appendedAt;
+    }
+    return SIZE_MAX;
+}
+
+size_t Vector_AppendVector(Vector_t *const vector, const Vector_t *const source)
+{
+    if(vector && source)
+    {
+        size_t count = Vector_Length(source);
+        if(!vector_ensure_capacity(vector, count))
+        {
+            return SIZE_MAX;
+        }
+        // source->items is read after the expansion because source may be the vector itself
+        size_t appendedAt = Vector_Length(vector);
+        if(count > 0)
+        {
+            bool sourceSorted = source->sorted;
+            memcpy(vector->next, source->items, count * sizeof(Vector_DataType_t));
+            vector->next += count;
+            vector_track_sorted(vector, appendedAt, count, !sourceSorted);
+        }
+        return appendedAt;
+    }
+    return SIZE_MAX;
+}
+
+bool Vector_InsertRange(Vector_t *const vector,
+                        size_t position,
+                        const Vector_DataType_t *const values,
+                        size_t count)
+{
+    if(vector && (values || count == 0))
+    {
+        size_t itemCount = Vector_Length(vector);
+        if(position > itemCount)
+        {
+            return false;
+        }
+        if(!vector_ensure_capacity(vector, count))
+        {
+            return false;
+        }
+        if(count > 0)
+        {
+            memmove(vector->items + position + count,
+                    vector->items + position,
+                    (itemCount - position) * sizeof(Vector_DataType_t));
+            memcpy(vector->items + position, values, count * sizeof(Vector_DataType_t));
+            vector->next += count;
+            vector_track_sorted(vector, position, count, true);
+        }
+        return true;
+    }
+    return false;
+}
+
 void Vector_Set(Vector_t *const vector, size_t position, Vector_DataType_t value)
 {
     if(vector)
@@ -157,46 +465,132 @@ void Vector_Set(Vector_t *const vector, size_t position, Vector_DataType_t value
         if(position >= itemCount)
             return;
 
+        Vector_DataType_t replaced = *(vector->items + position);
         *(vector->items + position) = value;
+        vector_index_replaced(vector, position, replaced);
+        vector_track_order(vector, position, 1, false);
     }
 }
 
 bool Vector_Contains(const Vector_t *const vector, Vector_DataType_t value)
+{
+    size_t found;
+    if(vector && vector_index_find(vector, value, &found))
+    {
+        return found != SIZE_MAX;
+    }
+    return Vector_SpanContains(Vector_GetSpan(vector), value);
+}
+
+size_t Vector_IndexOf(const Vector_t *const vector, Vector_DataType_t value, size_t from)
+{
+    size_t found;
+    if(vector && vector_index_find(vector, value, &found))
+    {
+        // the index knows only the first occurrence, later ones are searched for directly
+        if(found == SIZE_MAX || found >= from)
+        {
+            return found;
+        }
+    }
+    return Vector_SpanIndexOf(Vector_GetSpan(vector), value, from);
+}
+
+size_t Vector_LastIndexOf(const Vector_t *const vector, Vector_DataType_t value, size_t from)
 {
     if(vector)
     {
         size_t itemCount = Vector_Length(vector);
-        for(size_t i = 0; i < itemCount; i++)
+        size_t searched = from < itemCount ? from + 1 : itemCount;
+        if(vector->sorted)
         {
-            if(*(vector->items + i) == value)
+            size_t found = vector_upper_bound(vector->items, searched, value);
+            if(found > 0 && *(vector->items + found - 1) == value)
             {
-                return true;
+                return found - 1;
             }
+            return SIZE_MAX;
+        }
+        size_t found = vector_kernels_get()->find_last(vector->items, searched, value);
+        if(found < searched)
+        {
+            return found;
         }
     }
-    return false;
+    return SIZE_MAX;
 }
 
-size_t Vector_IndexOf(const Vector_t *const vector, Vector_DataType_t value, size_t from)
+size_t Vector_CountOf(const Vector_t *const vector, Vector_DataType_t value)
 {
     if(vector)
     {
         size_t itemCount = Vector_Length(vector);
-        if(from < itemCount)
+        if(vector->sorted)
         {
-            for(size_t i = from; i < itemCount; i++)
-            {
-                if(*(vector->items + i) == value)
-                {
-                    return i;
-                }
-            }
+            return vector_upper_bound(vector->items, itemCount, value)
+                   - vector_lower_bound(vector->items, itemCount, value);
         }
+        return vector_kernels_get()->count(vector->items, itemCount, value);
+    }
+    return 0;
+}
+
+bool Vector_IsSorted(const Vector_t *const vector)
+{
+    if(vector)
+    {
+        return vector->sorted;
+    }
+    return false;
+}
+
+size_t Vector_InsertSorted(Vector_t *const vector, Vector_DataType_t value)
+{
+    if(vector && vector->sorted)
+    {
+        size_t position = vector_upper_bound(vector->items, Vector_Length(vector), value);
+        if(Vector_InsertRange(vector, position, &value, 1))
+        {
+            return position;
+        }
+    }
+    return SIZE_MAX;
+}
+
+size_t Vector_LowerBound(const Vector_t *const vector, Vector_DataType_t value)
+{
+    if(vector && vector->sorted)
+    {
+        return vector_lower_bound(vector->items, Vector_Length(vector), value);
     }
     return SIZE_MAX;
 }
 
-void Vector_Fill(const Vector_t *const vector,
+size_t Vector_UpperBound(const Vector_t *const vector, Vector_DataType_t value)
+{
+    if(vector && vector->sorted)
+    {
+        return vector_upper_bound(vector->items, Vector_Length(vector), value);
+    }
+    return SIZE_MAX;
+}
+
+bool Vector_EqualRange(const Vector_t *const vector,
+                       Vector_DataType_t value,
+                       size_t *const first,
+                       size_t *const last)
+{
+    if(vector && vector->sorted && first && last)
+    {
+        size_t itemCount = Vector_Length(vector);
+        *first = vector_lower_bound(vector->items, itemCount, value);
+        *last = *first + vector_upper_bound(vector->items + *first, itemCount - *first, value);
+        return true;
+    }
+    return false;
+}
+
+void Vector_Fill(Vector_t *const vector,
                  Vector_DataType_t value,
                  size_t start_position,
                  size_t end_position)
@@ -207,10 +601,12 @@ void Vector_Fill(const Vector_t *const vector,
         if(start_position >= itemCount)
             return;
 
-        for(size_t i = start_position; i <= end_position && i < itemCount; i++)
+        size_t i = start_position;
+        for(; i <= end_position && i < itemCount; i++)
         {
             *(vector->items + i) = value;
         }
+        vector_track_sorted(vector, start_position, i - start_position, false);
     }
 }
 
@@ -218,9 +614,10 @@ void Vector_Destroy(Vector_t **const vector)
 {
     if(vector && *vector)
     {
-        myFree((*vector)->items);
+        Vector_DropIndex(*vector);
+        vector_free_items(*vector);
         (*vector)->items = NULL;
-        myFree(*vector);
+        (*vector)->allocator->free((*vector)->allocator->context, *vector, sizeof(Vector_t));
         *vector = NULL;
     }
     return;
@@ -230,32 +627,323 @@ void Merge(Vector_t * result, Vector_t * v1, Vector_t * v2)
 {
     if (result && v1 && v2)
     {
-        size_t i1 = 0, i2 = 0; // indexes
-        Vector_DataType_t e1, e2; //current elements of respective vectors
-        while(Vector_At(v1, i1, &e1) && Vector_At(v2, i2, &e2))
+        size_t n1 = Vector_Length(v1), n2 = Vector_Length(v2);
+        if(SIZE_MAX - n1 < n2 || !vector_ensure_capacity(result, n1 + n2))
         {
-            if(e1 <= e2)
+            return;
+        }
+
+        // spans are taken after the expansion because result may be one of the inputs
+        vector_merge_spans(result, Vector_GetSpan(v1), Vector_GetSpan(v2));
+    }
+}
+
+Vector_Span_t Vector_GetSpan(const Vector_t *const vector)
+{
+    Vector_Span_t span = {NULL, 0, true};
+    if(vector)
+    {
+        span.data = vector->items;
+        span.length = Vector_Length(vector);
+        span.sorted = vector->sorted;
+    }
+    return span;
+}
+
+Vector_Span_t Vector_SpanSlice(Vector_Span_t span, size_t start, size_t count)
+{
+    if(start >= span.length)
+    {
+        Vector_Span_t empty = {NULL, 0, true};
+        return empty;
+    }
+    span.data += start;
+    span.length = count < span.length - start ? count : span.length - start;
+    return span;
+}
+
+size_t Vector_SpanIndexOf(Vector_Span_t span, Vector_DataType_t value, size_t from)
+{
+    if(from < span.length)
+    {
+        const Vector_DataType_t *items = span.data + from;
+        size_t itemCount = span.length - from;
+        size_t found;
+        if(span.sorted)
+        {
+            found = vector_lower_bound(items, itemCount, value);
+            if(found < itemCount && items[found] != value)
             {
-                Vector_Append(result, e1);
-                i1++;
+                found = itemCount;
             }
-            else
+        }
+        else
+        {
+            found = vector_kernels_get()->find_first(items, itemCount, value);
+        }
+        if(found < itemCount)
+        {
+            return from + found;
+        }
+    }
+    return SIZE_MAX;
+}
+
+bool Vector_SpanContains(Vector_Span_t span, Vector_DataType_t value)
+{
+    return Vector_SpanIndexOf(span, value, 0) != SIZE_MAX;
+}
+
+bool Vector_SpanMerge(Vector_t *const result, Vector_Span_t a, Vector_Span_t b)
+{
+    if(result == NULL || SIZE_MAX - a.length < b.length
+       || !vector_ensure_capacity(result, a.length + b.length))
+    {
+        return false;
+    }
+    vector_merge_spans(result, a, b);
+    return true;
+}
+
+/* Internal functions definitions ----------------------------------------------------------------*/
+void vector_init(Vector_t *const vector,
+                 Vector_DataType_t *items,
+                 size_t size,
+                 const Vector_Growth_t *const growth,
+                 const Vector_Allocator_t *const allocator)
+{
+    vector->items = items;
+    vector->next = items;
+    vector->size = size;
+    vector->alloc_step = growth->alloc_step;
+    vector->growth_policy = growth->policy;
+    vector->growth_factor = growth->factor;
+    vector->growth_threshold = growth->threshold;
+    vector->sorted = true;
+    vector->allocator = allocator;
+    vector->index = NULL;
+}
+
+const Vector_Allocator_t *vector_derived_allocator(const Vector_t *const vector)
+{
+    return vector->allocator->alloc ? vector->allocator : &Vector_DefaultAllocator;
+}
+
+bool vector_ensure_capacity(Vector_t *const vector, size_t count)
+{
+    size_t itemCount = Vector_Length(vector);
+    if(count <= vector->size - itemCount)
+    {
+        return true;
+    }
+    if(SIZE_MAX - itemCount < count)
+    {
+        return false;
+    }
+    return vector_set_capacity(vector, vector_next_capacity(vector, itemCount + count));
+}
+
+void vector_track_sorted(Vector_t *const vector, size_t position, size_t count, bool scan)
+{
+    if(vector->index && count > 0)
+    {
+        vector_index_written(vector, position);
+    }
+    vector_track_order(vector, position, count, scan);
+}
+
+size_t vector_lower_bound(const Vector_DataType_t *items, size_t count, Vector_DataType_t value)
+{
+    if(count == 0)
+    {
+        return 0;
+    }
+
+    const Vector_DataType_t *base = items;
+    while(count > 1)
+    {
+        size_t half = count / 2;
+        base = base[half] < value ? base + half : base;
+        count -= half;
+    }
+    return (size_t)(base - items) + (*base < value);
+}
+
+size_t vector_upper_bound(const Vector_DataType_t *items, size_t count, Vector_DataType_t value)
+{
+    if(count == 0)
+    {
+        return 0;
+    }
+
+    const Vector_DataType_t *base = items;
+    while(count > 1)
+    {
+        size_t half = count / 2;
+        base = base[half] <= value ? base + half : base;
+        count -= half;
+    }
+    return (size_t)(base - items) + (*base <= value);
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Updates \ref Vector_t.sorted like \ref vector_track_sorted does, but leaves the index alone. */
+static void vector_track_order(Vector_t *const vector, size_t position, size_t count, bool scan)
+{
+    if(!vector->sorted || count == 0)
+    {
+        return;
+    }
+
+    const Vector_DataType_t *items = vector->items;
+    size_t end = position + count;
+    if(position > 0 && items[position - 1] > items[position])
+    {
+        vector->sorted = false;
+    }
+    else if(end < Vector_Length(vector) && items[end - 1] > items[end])
+    {
+        vector->sorted = false;
+    }
+    else if(scan)
+    {
+        for(size_t i = position + 1; i < end; i++)
+        {
+            if(items[i - 1] > items[i])
             {
-                Vector_Append(result, e2);
-                i2++;
+                vector->sorted = false;
+                return;
             }
         }
-        while(Vector_At(v1, i1, &e1))
+    }
+}
+
+/*! Computes the capacity the \a vector should be expanded to so that it can hold at least \a
+ * required items. The result saturates at SIZE_MAX.
+ */
+static size_t vector_next_capacity(const Vector_t *const vector, size_t required)
+{
+    size_t capacity = vector->size;
+    bool geometric = vector->growth_policy == VECTOR_GROWTH_GEOMETRIC
+                     || (vector->growth_policy == VECTOR_GROWTH_HYBRID
+                         && capacity >= vector->growth_threshold);
+
+    if(geometric)
+    {
+        double grown = (double)capacity * vector->growth_factor;
+        capacity = grown >= (double)SIZE_MAX ? SIZE_MAX : (size_t)grown;
+    }
+    else
+    {
+        capacity = SIZE_MAX - capacity < vector->alloc_step ? SIZE_MAX
+                                                            : capacity + vector->alloc_step;
+    }
+
+    return capacity < required ? required : capacity;
+}
+
+/*! Reallocates \ref Vector_t.items to hold exactly \a capacity cells. The \a vector is left
+ * untouched when the allocation fails.
+ */
+static bool vector_set_capacity(Vector_t *const vector, size_t capacity)
+{
+    if(capacity > SIZE_MAX / sizeof(Vector_DataType_t))
+    {
+        return false;
+    }
+
+    size_t itemCount = Vector_Length(vector);
+    const Vector_Allocator_t *allocator = vector->allocator;
+    Vector_DataType_t *temp;
+#if VECTOR_INLINE_CAPACITY > 0
+    // allocators that cannot allocate new blocks keep the items in their own storage
+    if(capacity <= VECTOR_INLINE_CAPACITY && allocator->alloc != NULL)
+    {
+        if(vector->items != vector->inline_items)
         {
-            Vector_Append(result, e1);
-            i1++;
+            if(itemCount > 0)
+            {
+                memcpy(vector->inline_items, vector->items, itemCount * sizeof(Vector_DataType_t));
+            }
+            vector_free_items(vector);
         }
-        while(Vector_At(v2, i2, &e2))
+        vector->items = vector->inline_items;
+        vector->size = VECTOR_INLINE_CAPACITY;
+        vector->next = vector->items + itemCount;
+        return true;
+    }
+    if(vector->items == vector->inline_items)
+    {
+        temp = allocator->alloc(allocator->context, capacity * sizeof(Vector_DataType_t));
+        if(temp != NULL)
         {
-            Vector_Append(result, e2);
-            i2++;
+            memcpy(temp, vector->inline_items, itemCount * sizeof(Vector_DataType_t));
         }
     }
+    else
+#endif
+    {
+        temp = allocator->realloc(allocator->context,
+                                  vector->items,
+                                  vector->size * sizeof(Vector_DataType_t),
+                                  capacity * sizeof(Vector_DataType_t));
+    }
+    if(temp == NULL)
+    {
+        return false;
+    }
+    vector->items = temp;
+    vector->size = capacity;
+    vector->next = vector->items + itemCount;
+    return true;
 }
 
-/* Private function definitions ------------------------------------------------------------------*/
+/*! Releases \ref Vector_t.items unless they are stored inline, the pointers are left as they
+ * are.
+ */
+static void vector_free_items(Vector_t *const vector)
+{
+#if VECTOR_INLINE_CAPACITY > 0
+    if(vector->items == vector->inline_items)
+    {
+        return;
+    }
+#endif
+    vector->allocator->free(vector->allocator->context,
+                            vector->items,
+                            vector->size * sizeof(Vector_DataType_t));
+}
+
+/*! Appends the merged items of the spans \a a and \a b to the \a result, which must have room for
+ * all of them.
+ */
+static void vector_merge_spans(Vector_t *const result, Vector_Span_t a, Vector_Span_t b)
+{
+    const Vector_DataType_t *i1 = a.data, *end1 = a.data + a.length;
+    const Vector_DataType_t *i2 = b.data, *end2 = b.data + b.length;
+    size_t appendedAt = Vector_Length(result);
+    Vector_DataType_t *out = result->next;
+    while(i1 < end1 && i2 < end2)
+    {
+        if(*i1 <= *i2)
+        {
+            *out++ = *i1++;
+        }
+        else
+        {
+            *out++ = *i2++;
+        }
+    }
+    if(i1 < end1)
+    {
+        memcpy(out, i1, (size_t)(end1 - i1) * sizeof(Vector_DataType_t));
+        out += end1 - i1;
+    }
+    if(i2 < end2)
+    {
+        memcpy(out, i2, (size_t)(end2 - i2) * sizeof(Vector_DataType_t));
+        out += end2 - i2;
+    }
+    result->next = out;
+    vector_track_sorted(result, appendedAt, a.length + b.length, !(a.sorted && b.sorted));
+}
@@ -0,0 +1,143 @@
+/*!
+ * \file       vector_alloc.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Default and counting allocators of the vector module
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include <mymalloc.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/* Private macros --------------------------------------------------------------------------------*/
+#define UNUSED(x) (void)x
+
+/* Private function declarations -----------------------------------------------------------------*/
+static void *default_alloc(void *context, size_t size);
+static void *default_realloc(void *context, void *ptr, size_t old_size, size_t new_size);
+static void default_free(void *context, void *ptr, size_t size);
+static void *counting_alloc(void *context, size_t size);
+static void *counting_realloc(void *context, void *ptr, size_t old_size, size_t new_size);
+static void counting_free(void *context, void *ptr, size_t size);
+static void counting_add_live(Vector_AllocStats_t *stats, size_t size);
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Exported variables ----------------------------------------------------------------------------*/
+const Vector_Allocator_t Vector_DefaultAllocator = {
+    .alloc = default_alloc,
+    .realloc = default_realloc,
+    .free = default_free,
+    .context = NULL,
+};
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+void Vector_CountingAllocatorInit(Vector_CountingAllocator_t *const counting,
+                                  const Vector_Allocator_t *const backend)
+{
+    if(counting)
+    {
+        counting->allocator.alloc = counting_alloc;
+        counting->allocator.realloc = counting_realloc;
+        counting->allocator.free = counting_free;
+        counting->allocator.context = counting;
+        counting->backend = backend ? backend : &Vector_DefaultAllocator;
+        counting->stats = (Vector_AllocStats_t){0};
+    }
+}
+
+void Vector_CountingAllocatorReset(Vector_CountingAllocator_t *const counting)
+{
+    if(counting)
+    {
+        size_t live = counting->stats.live_bytes;
+        counting->stats = (Vector_AllocStats_t){.live_bytes = live, .peak_bytes = live};
+    }
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+static void *default_alloc(void *context, size_t size)
+{
+    UNUSED(context);
+    return myMalloc(size);
+}
+
+static void *default_realloc(void *context, void *ptr, size_t old_size, size_t new_size)
+{
+    UNUSED(context);
+    UNUSED(old_size);
+    return myRealloc(ptr, new_size);
+}
+
+static void default_free(void *context, void *ptr, size_t size)
+{
+    UNUSED(context);
+    UNUSED(size);
+    myFree(ptr);
+}
+
+static void *counting_alloc(void *context, size_t size)
+{
+    Vector_CountingAllocator_t *counting = context;
+    void *ptr = counting->backend->alloc(counting->backend->context, size);
+    if(ptr)
+    {
+        counting->stats.allocations++;
+        counting_add_live(&counting->stats, size);
+    }
+    return ptr;
+}
+
+/*! Counts a reallocation. A block that ends up at another address is assumed to be copied by the
+ * backend, so the preserved bytes are added to \ref Vector_AllocStats_t.bytes_moved.
+ */
+static void *counting_realloc(void *context, void *ptr, size_t old_size, size_t new_size)
+{
+    Vector_CountingAllocator_t *counting = context;
+    void *moved = counting->backend->realloc(counting->backend->context, ptr, old_size, new_size);
+    if(moved == NULL)
+    {
+        return NULL;
+    }
+
+    if(ptr == NULL)
+    {
+        counting->stats.allocations++;
+    }
+    else
+    {
+        counting->stats.reallocations++;
+        if(moved != ptr)
+        {
+            counting->stats.bytes_moved += old_size < new_size ? old_size : new_size;
+        }
+    }
+    counting->stats.live_bytes -= old_size;
+    counting_add_live(&counting->stats, new_size);
+    return moved;
+}
+
+static void counting_free(void *context, void *ptr, size_t size)
+{
+    Vector_CountingAllocator_t *counting = context;
+    if(ptr)
+    {
+        counting->stats.frees++;
+        counting->stats.live_bytes -= size;
+    }
+    counting->backend->free(counting->backend->context, ptr, size);
+}
+
+static void counting_add_live(Vector_AllocStats_t *stats, size_t size)
+{
+    stats->live_bytes += size;
+    if(stats->live_bytes > stats->peak_bytes)
+    {
+        stats->peak_bytes = stats->live_bytes;
+    }
+}
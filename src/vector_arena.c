@@ -0,0 +1,429 @@
+/*!
+ * \file       vector_arena.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Arena allocator for short-lived vectors
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include <stdalign.h>
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Block of memory obtained from the backend, blocks of the arena are cut from it by bumping the
+ * \ref ArenaChunk_t.top pointer. The usable memory follows the header. A dedicated chunk holds
+ * exactly one block bigger than the regular chunk size.
+ */
+typedef struct ArenaChunk {
+  /*! Next chunk of the same list. */
+  struct ArenaChunk *next;
+
+  /*! Previous chunk of the list of dedicated chunks, which are unlinked when their block is
+   * released. */
+  struct ArenaChunk *prev;
+
+  /*! Number of usable bytes. */
+  size_t size;
+
+  /*! First free byte. */
+  unsigned char *top;
+
+  /*! Pointer behind the last usable byte. */
+  unsigned char *end;
+} ArenaChunk_t;
+
+struct Vector_Arena {
+  /*! Allocator table whose context is the arena itself. */
+  Vector_Allocator_t allocator;
+
+  /*! Allocator of the chunks and of the arena structure. */
+  const Vector_Allocator_t *backend;
+
+  /*! Size of regular chunks, bigger blocks get a dedicated chunk. */
+  size_t chunk_size;
+
+  /*! Regular chunks that are in use, the head is the one blocks are currently cut from. */
+  ArenaChunk_t *chunks;
+
+  /*! Dedicated chunks of the blocks bigger than \ref Vector_Arena.chunk_size. */
+  ArenaChunk_t *dedicated;
+
+  /*! Regular chunks released by \ref Vector_ArenaReset that are reused before new are allocated. */
+  ArenaChunk_t *spare;
+
+  /*! Released blocks of each size class, the first bytes of a block point to the next one. */
+  void *free_lists[];
+};
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Alignment of all blocks, it is also the granularity of the size classes. */
+#define ARENA_ALIGN alignof(max_align_t)
+
+/*! Largest block that is kept in a free list when it is released. */
+#define ARENA_CLASS_MAX 1024
+
+/*! Number of size classes, i.e. of the free lists. */
+#define ARENA_CLASSES (ARENA_CLASS_MAX / ARENA_ALIGN)
+
+/*! Size of the chunk header rounded up so that the usable memory is aligned. */
+#define ARENA_CHUNK_HEADER ((sizeof(ArenaChunk_t) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static void *arena_alloc(void *context, size_t size);
+static void *arena_realloc(void *context, void *ptr, size_t old_size, size_t new_size);
+static void arena_free(void *context, void *ptr, size_t size);
+static ArenaChunk_t *arena_add_chunk(Vector_Arena_t *arena);
+static void *arena_alloc_dedicated(Vector_Arena_t *arena, size_t size);
+static void *arena_realloc_dedicated(Vector_Arena_t *arena, void *ptr, size_t size);
+static void arena_free_dedicated(Vector_Arena_t *arena, void *ptr);
+static void arena_link_dedicated(Vector_Arena_t *arena, ArenaChunk_t *chunk);
+static void arena_free_chunks(Vector_Arena_t *arena, ArenaChunk_t *chunk);
+static size_t arena_round(size_t size);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+Vector_Arena_t *Vector_ArenaCreate(size_t chunk_size)
+{
+    return Vector_ArenaCreateWithAllocator(chunk_size, &Vector_DefaultAllocator);
+}
+
+Vector_Arena_t *Vector_ArenaCreateWithAllocator(size_t chunk_size,
+                                                const Vector_Allocator_t *const backend)
+{
+    if(backend == NULL || backend->alloc == NULL)
+    {
+        return NULL;
+    }
+    size_t arenaSize = sizeof(Vector_Arena_t) + ARENA_CLASSES * sizeof(void *);
+    Vector_Arena_t *arena = backend->alloc(backend->context, arenaSize);
+    if(arena == NULL)
+    {
+        return NULL;
+    }
+    memset(arena, 0, arenaSize);
+
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.realloc = arena_realloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.context = arena;
+    arena->backend = backend;
+    arena->chunk_size = arena_round(chunk_size ? chunk_size : VECTOR_ARENA_CHUNK_SIZE);
+    return arena;
+}
+
+const Vector_Allocator_t *Vector_ArenaAllocator(Vector_Arena_t *const arena)
+{
+    return arena ? &arena->allocator : NULL;
+}
+
+Vector_t *Vector_CreateInArena(Vector_Arena_t *const arena, size_t initial_size, size_t alloc_step)
+{
+    if(arena)
+    {
+        Vector_Growth_t growth = {
+            .policy = VECTOR_GROWTH_FIXED,
+            .alloc_step = alloc_step,
+            .factor = VECTOR_GROWTH_DEFAULT_FACTOR,
+            .threshold = 0,
+        };
+        return Vector_CreateWithAllocator(initial_size, &growth, &arena->allocator);
+    }
+    return NULL;
+}
+
+void Vector_ArenaReset(Vector_Arena_t *const arena)
+{
+    if(arena)
+    {
+        ArenaChunk_t *chunk = arena->chunks;
+        while(chunk)
+        {
+            ArenaChunk_t *next = chunk->next;
+            chunk->top = (unsigned char *)chunk + ARENA_CHUNK_HEADER;
+            chunk->next = arena->spare;
+            arena->spare = chunk;
+            chunk = next;
+        }
+        arena->chunks = NULL;
+        arena_free_chunks(arena, arena->dedicated);
+        arena->dedicated = NULL;
+        memset(arena->free_lists, 0, ARENA_CLASSES * sizeof(void *));
+    }
+}
+
+void Vector_ArenaDestroy(Vector_Arena_t **const arena)
+{
+    if(arena && *arena)
+    {
+        arena_free_chunks(*arena, (*arena)->chunks);
+        arena_free_chunks(*arena, (*arena)->dedicated);
+        arena_free_chunks(*arena, (*arena)->spare);
+        const Vector_Allocator_t *backend = (*arena)->backend;
+        backend->free(backend->context,
+                      *arena,
+                      sizeof(Vector_Arena_t) + ARENA_CLASSES * sizeof(void *));
+        *arena = NULL;
+    }
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Takes a block from the free list of its size class or cuts it from the current chunk, blocks
+ * bigger than the regular chunk size get a dedicated chunk.
+ */
+static void *arena_alloc(void *context, size_t size)
+{
+    Vector_Arena_t *arena = context;
+    size_t rounded = arena_round(size);
+    if(rounded == 0)
+    {
+        return NULL;
+    }
+    if(rounded > arena->chunk_size)
+    {
+        return arena_alloc_dedicated(arena, rounded);
+    }
+
+    if(rounded <= ARENA_CLASS_MAX)
+    {
+        void **list = &arena->free_lists[rounded / ARENA_ALIGN - 1];
+        if(*list)
+        {
+            void *ptr = *list;
+            *list = *(void **)ptr;
+            return ptr;
+        }
+    }
+
+    ArenaChunk_t *chunk = arena->chunks;
+    if(chunk == NULL || (size_t)(chunk->end - chunk->top) < rounded)
+    {
+        chunk = arena_add_chunk(arena);
+        if(chunk == NULL)
+        {
+            return NULL;
+        }
+    }
+    void *ptr = chunk->top;
+    chunk->top += rounded;
+    return ptr;
+}
+
+/*! Resizes the block in place when it is the last one cut from the current chunk, which is the
+ * usual case of a vector growing while no other block is allocated. A block that stays bigger than
+ * the regular chunk size is resized together with its dedicated chunk by the backend. Otherwise the
+ * block is copied.
+ */
+static void *arena_realloc(void *context, void *ptr, size_t old_size, size_t new_size)
+{
+    Vector_Arena_t *arena = context;
+    if(ptr == NULL)
+    {
+        return arena_alloc(arena, new_size);
+    }
+
+    size_t oldRounded = arena_round(old_size), newRounded = arena_round(new_size);
+    if(newRounded == 0)
+    {
+        return NULL;
+    }
+    if(oldRounded > arena->chunk_size && newRounded > arena->chunk_size)
+    {
+        return arena_realloc_dedicated(arena, ptr, newRounded);
+    }
+    ArenaChunk_t *chunk = arena->chunks;
+    unsigned char *block = ptr;
+    if(chunk && block + oldRounded == chunk->top && newRounded <= (size_t)(chunk->end - block))
+    {
+        chunk->top = block + newRounded;
+        return ptr;
+    }
+    if(newRounded <= oldRounded && oldRounded <= arena->chunk_size)
+    {
+        return ptr;  // the tail is lost until the arena is reset
+    }
+
+    void *moved = arena_alloc(arena, new_size);
+    if(moved)
+    {
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+        arena_free(arena, ptr, old_size);
+    }
+    return moved;
+}
+
+/*! Returns the block to the current chunk when it is on its top or to the free list of its size
+ * class, dedicated chunks are returned to the backend. Other blocks are reclaimed by \ref
+ * Vector_ArenaReset only.
+ */
+static void arena_free(void *context, void *ptr, size_t size)
+{
+    Vector_Arena_t *arena = context;
+    if(ptr == NULL)
+    {
+        return;
+    }
+
+    size_t rounded = arena_round(size);
+    ArenaChunk_t *chunk = arena->chunks;
+    unsigned char *block = ptr;
+    if(rounded > arena->chunk_size)
+    {
+        arena_free_dedicated(arena, ptr);
+    }
+    else if(chunk && block + rounded == chunk->top)
+    {
+        chunk->top = block;
+    }
+    else if(rounded <= ARENA_CLASS_MAX)
+    {
+        void **list = &arena->free_lists[rounded / ARENA_ALIGN - 1];
+        *(void **)ptr = *list;
+        *list = ptr;
+    }
+}
+
+/*! Makes an empty regular chunk the current one, a spare chunk is used when there is any. */
+static ArenaChunk_t *arena_add_chunk(Vector_Arena_t *arena)
+{
+    ArenaChunk_t *chunk;
+    if(arena->spare)
+    {
+        chunk = arena->spare;
+        arena->spare = chunk->next;
+    }
+    else
+    {
+        if(arena->chunk_size > SIZE_MAX - ARENA_CHUNK_HEADER)
+        {
+            return NULL;
+        }
+        chunk = arena->backend->alloc(arena->backend->context,
+                                      ARENA_CHUNK_HEADER + arena->chunk_size);
+        if(chunk == NULL)
+        {
+            return NULL;
+        }
+        chunk->size = arena->chunk_size;
+        chunk->top = (unsigned char *)chunk + ARENA_CHUNK_HEADER;
+        chunk->end = chunk->top + arena->chunk_size;
+    }
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    return chunk;
+}
+
+/*! Allocates a dedicated chunk for a block of the rounded \a size, the current regular chunk stays
+ * the one small blocks are cut from.
+ */
+static void *arena_alloc_dedicated(Vector_Arena_t *arena, size_t size)
+{
+    if(size > SIZE_MAX - ARENA_CHUNK_HEADER)
+    {
+        return NULL;
+    }
+    ArenaChunk_t *chunk = arena->backend->alloc(arena->backend->context, ARENA_CHUNK_HEADER + size);
+    if(chunk == NULL)
+    {
+        return NULL;
+    }
+    chunk->size = size;
+    chunk->top = (unsigned char *)chunk + ARENA_CHUNK_HEADER + size;
+    chunk->end = chunk->top;
+    arena_link_dedicated(arena, chunk);
+    return (unsigned char *)chunk + ARENA_CHUNK_HEADER;
+}
+
+/*! Resizes the dedicated chunk of the block at \a ptr to hold the rounded \a size bytes. */
+static void *arena_realloc_dedicated(Vector_Arena_t *arena, void *ptr, size_t size)
+{
+    if(size > SIZE_MAX - ARENA_CHUNK_HEADER)
+    {
+        return NULL;
+    }
+    ArenaChunk_t *chunk = (ArenaChunk_t *)((unsigned char *)ptr - ARENA_CHUNK_HEADER);
+    ArenaChunk_t *prev = chunk->prev, *next = chunk->next;
+    chunk = arena->backend->realloc(arena->backend->context,
+                                    chunk,
+                                    ARENA_CHUNK_HEADER + chunk->size,
+                                    ARENA_CHUNK_HEADER + size);
+    if(chunk == NULL)
+    {
+        return NULL;
+    }
+
+    // the chunk may have moved, so its neighbours are pointed to the new address
+    if(prev)
+    {
+        prev->next = chunk;
+    }
+    else
+    {
+        arena->dedicated = chunk;
+    }
+    if(next)
+    {
+        next->prev = chunk;
+    }
+    chunk->size = size;
+    chunk->top = (unsigned char *)chunk + ARENA_CHUNK_HEADER + size;
+    chunk->end = chunk->top;
+    return (unsigned char *)chunk + ARENA_CHUNK_HEADER;
+}
+
+/*! Unlinks the dedicated chunk of the block at \a ptr and returns it to the backend. */
+static void arena_free_dedicated(Vector_Arena_t *arena, void *ptr)
+{
+    ArenaChunk_t *chunk = (ArenaChunk_t *)((unsigned char *)ptr - ARENA_CHUNK_HEADER);
+    if(chunk->prev)
+    {
+        chunk->prev->next = chunk->next;
+    }
+    else
+    {
+        arena->dedicated = chunk->next;
+    }
+    if(chunk->next)
+    {
+        chunk->next->prev = chunk->prev;
+    }
+    arena->backend->free(arena->backend->context, chunk, ARENA_CHUNK_HEADER + chunk->size);
+}
+
+static void arena_link_dedicated(Vector_Arena_t *arena, ArenaChunk_t *chunk)
+{
+    chunk->prev = NULL;
+    chunk->next = arena->dedicated;
+    if(chunk->next)
+    {
+        chunk->next->prev = chunk;
+    }
+    arena->dedicated = chunk;
+}
+
+static void arena_free_chunks(Vector_Arena_t *arena, ArenaChunk_t *chunk)
+{
+    while(chunk)
+    {
+        ArenaChunk_t *next = chunk->next;
+        arena->backend->free(arena->backend->context, chunk, ARENA_CHUNK_HEADER + chunk->size);
+        chunk = next;
+    }
+}
+
+/*! Rounds the \a size up to the block alignment, zero sized blocks take one unit. Zero is returned
+ * when the rounded size does not fit into size_t.
+ */
+static size_t arena_round(size_t size)
+{
+    if(size > SIZE_MAX - ARENA_ALIGN)
+    {
+        return 0;
+    }
+    return size == 0 ? ARENA_ALIGN : (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
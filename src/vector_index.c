@@ -0,0 +1,454 @@
+/*!
+ * \file       vector_index.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Hash index of the vector items
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include "vector_internal.h"
+#include "vector_kernels.h"
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Multiplier of the Fibonacci hashing, 2^64 divided by the golden ratio. */
+#define INDEX_HASH_MULTIPLIER 0x9E3779B97F4A7C15ull
+
+/*! Smallest number of slots of the table. */
+#define INDEX_MIN_CAPACITY 16
+
+/*! Position stored in an empty slot. */
+#define INDEX_EMPTY SIZE_MAX
+
+/*! Flag of the position telling that a later item may have the same value. It is conservative: it
+ * is set whenever a duplicate is indexed and cleared only by a rebuild. Positions of the items
+ * never reach this bit, since they are smaller than SIZE_MAX / sizeof(Vector_DataType_t).
+ */
+#define INDEX_DUPLICATED ((SIZE_MAX >> 1) + 1)
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Slot of the table, it holds a value and the position of its first occurrence. */
+typedef struct {
+  Vector_DataType_t value;
+  size_t position;
+} IndexSlot_t;
+
+struct Vector_Index {
+  /*! Table of the slots, NULL until the index is built. */
+  IndexSlot_t *slots;
+
+  /*! Number of slots, a power of 2. */
+  size_t capacity;
+
+  /*! The home slot of a value is the top bits of its hash, i.e. the hash shifted by this. */
+  unsigned shift;
+
+  /*! Number of used slots. */
+  size_t count;
+
+  /*! Number of leading items of the vector that are indexed. */
+  size_t covered;
+
+  /*! The table does not describe the items, it was not built yet or its rebuild failed. */
+  bool stale;
+
+  /*! Allocator of this structure and of the table. */
+  const Vector_Allocator_t *allocator;
+};
+
+/* Private function declarations -----------------------------------------------------------------*/
+static size_t index_home(const Vector_Index_t *index, Vector_DataType_t value);
+static size_t index_position(const IndexSlot_t *slot);
+static bool index_resize(Vector_Index_t *index, size_t capacity);
+static bool index_reserve(Vector_Index_t *index);
+static void index_insert(Vector_Index_t *index, Vector_DataType_t value, size_t position);
+static IndexSlot_t *index_slot(const Vector_Index_t *index, Vector_DataType_t value);
+static void index_delete(Vector_Index_t *index, IndexSlot_t *slot);
+static bool index_catch_up(Vector_Index_t *index, const Vector_t *const vector);
+static bool index_rebuild(Vector_Index_t *index, const Vector_t *const vector);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+bool Vector_BuildIndex(Vector_t *const vector, bool lazy)
+{
+    if(vector == NULL)
+    {
+        return false;
+    }
+
+    if(vector->index == NULL)
+    {
+        const Vector_Allocator_t *allocator = vector_derived_allocator(vector);
+        Vector_Index_t *index = allocator->alloc(allocator->context, sizeof(Vector_Index_t));
+        if(index == NULL)
+        {
+            return false;
+        }
+        index->slots = NULL;
+        index->capacity = 0;
+        index->shift = 0;
+        index->count = 0;
+        index->covered = 0;
+        index->allocator = allocator;
+        vector->index = index;
+    }
+    vector->index->stale = true;
+    if(!lazy && !index_rebuild(vector->index, vector))
+    {
+        Vector_DropIndex(vector);
+        return false;
+    }
+    return true;
+}
+
+void Vector_DropIndex(Vector_t *const vector)
+{
+    if(vector && vector->index)
+    {
+        Vector_Index_t *index = vector->index;
+        index->allocator->free(index->allocator->context,
+                               index->slots,
+                               index->capacity * sizeof(IndexSlot_t));
+        index->allocator->free(index->allocator->context, index, sizeof(Vector_Index_t));
+        vector->index = NULL;
+    }
+}
+
+size_t Vector_IndexMemorySize(const Vector_t *const vector)
+{
+    if(vector && vector->index)
+    {
+        return sizeof(Vector_Index_t) + vector->index->capacity * sizeof(IndexSlot_t);
+    }
+    return 0;
+}
+
+/* Internal functions definitions ----------------------------------------------------------------*/
+void vector_index_written(Vector_t *const vector, size_t position)
+{
+    Vector_Index_t *index = vector->index;
+    if(index == NULL)
+    {
+        return;
+    }
+    if(index->stale || position < index->covered)
+    {
+        index_rebuild(index, vector);
+    }
+    else
+    {
+        index_catch_up(index, vector);
+    }
+}
+
+void vector_index_replaced(Vector_t *const vector, size_t position, Vector_DataType_t old_value)
+{
+    Vector_Index_t *index = vector->index;
+    if(index == NULL)
+    {
+        return;
+    }
+    size_t itemCount = Vector_Length(vector);
+    if(index->stale || index->covered != itemCount)
+    {
+        index_rebuild(index, vector);
+        return;
+    }
+
+    Vector_DataType_t value = vector->items[position];
+    if(value == old_value)
+    {
+        return;
+    }
+    // the old value keeps its entry unless this was its first occurrence, a later duplicate then
+    // takes the entry over, which is searched for only when one was ever indexed
+    IndexSlot_t *slot = index_slot(index, old_value);
+    if(slot && index_position(slot) == position)
+    {
+        size_t count = itemCount - position - 1;
+        size_t next = count;
+        if(slot->position & INDEX_DUPLICATED)
+        {
+            next = vector_kernels_get()->find_first(vector->items + position + 1, count, old_value);
+        }
+        if(next < count)
+        {
+            slot->position = (position + 1 + next) | INDEX_DUPLICATED;
+        }
+        else
+        {
+            index_delete(index, slot);
+        }
+    }
+    if(!index_reserve(index))
+    {
+        index->stale = true;
+        return;
+    }
+    index_insert(index, value, position);
+}
+
+void vector_index_truncated(Vector_t *const vector, size_t old_length)
+{
+    Vector_Index_t *index = vector->index;
+    if(index == NULL)
+    {
+        return;
+    }
+    size_t itemCount = Vector_Length(vector);
+    if(index->stale || index->covered != old_length)
+    {
+        index_rebuild(index, vector);
+        return;
+    }
+
+    // the removed items are still in the memory behind the end of the vector
+    for(size_t i = itemCount; i < old_length; i++)
+    {
+        IndexSlot_t *slot = index_slot(index, vector->items[i]);
+        if(slot && index_position(slot) >= itemCount)
+        {
+            index_delete(index, slot);
+        }
+    }
+    index->covered = itemCount;
+}
+
+void vector_index_rebuild(Vector_t *const vector)
+{
+    if(vector->index)
+    {
+        index_rebuild(vector->index, vector);
+    }
+}
+
+void vector_index_refresh(Vector_t *const vector)
+{
+    Vector_Index_t *index = vector->index;
+    if(index && (index->stale || index->covered != Vector_Length(vector))
+       && !index_rebuild(index, vector))
+    {
+        Vector_DropIndex(vector);
+    }
+}
+
+bool vector_index_find(const Vector_t *const vector,
+                       Vector_DataType_t value,
+                       size_t *const position)
+{
+    const Vector_Index_t *index = vector->index;
+    if(index == NULL || index->stale || index->covered != Vector_Length(vector))
+    {
+        return false;
+    }
+    const IndexSlot_t *slot = index_slot(index, value);
+    *position = slot ? index_position(slot) : SIZE_MAX;
+    return true;
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+static size_t index_home(const Vector_Index_t *index, Vector_DataType_t value)
+{
+    return (size_t)(((uint64_t)value * INDEX_HASH_MULTIPLIER) >> index->shift);
+}
+
+/*! Returns the position stored in a used \a slot without \ref INDEX_DUPLICATED. */
+static size_t index_position(const IndexSlot_t *slot)
+{
+    return slot->position & ~INDEX_DUPLICATED;
+}
+
+/*! Replaces the table by an empty one of \a capacity slots, a power of 2. The index is not modified
+ * when the allocation fails.
+ */
+static bool index_resize(Vector_Index_t *index, size_t capacity)
+{
+    IndexSlot_t *slots = index->allocator->alloc(index->allocator->context,
+                                                 capacity * sizeof(IndexSlot_t));
+    if(slots == NULL)
+    {
+        return false;
+    }
+    for(size_t i = 0; i < capacity; i++)
+    {
+        slots[i].position = INDEX_EMPTY;
+    }
+
+    IndexSlot_t *old = index->slots;
+    size_t oldCapacity = index->capacity;
+    unsigned bits = 0;
+    while(((size_t)1 << bits) < capacity)
+    {
+        bits++;
+    }
+    index->slots = slots;
+    index->capacity = capacity;
+    index->shift = 64 - bits;
+    index->count = 0;
+    for(size_t i = 0; i < oldCapacity; i++)
+    {
+        if(old[i].position != INDEX_EMPTY)
+        {
+            index_insert(index, old[i].value, old[i].position);
+        }
+    }
+    index->allocator->free(index->allocator->context, old, oldCapacity * sizeof(IndexSlot_t));
+    return true;
+}
+
+/*! Makes room for one more entry, the table is doubled when it would be used over 7/8. */
+static bool index_reserve(Vector_Index_t *index)
+{
+    if(index->count < index->capacity - index->capacity / 8)
+    {
+        return true;
+    }
+    return index->capacity <= SIZE_MAX / 2 / sizeof(IndexSlot_t)
+           && index_resize(index, index->capacity * 2);
+}
+
+/*! Inserts the \a value unless it is already present, i.e. the first occurrence is kept and marked
+ * by \ref INDEX_DUPLICATED. An entry that is farther from its home slot than the resident takes the
+ * slot and the resident continues (Robin Hood), which keeps the probe sequences short and lets a
+ * failed lookup stop early.
+ */
+static void index_insert(Vector_Index_t *index, Vector_DataType_t value, size_t position)
+{
+    size_t mask = index->capacity - 1;
+    IndexSlot_t entry = {value, position};
+    size_t distance = 0;
+    for(size_t slot = index_home(index, value);; slot = (slot + 1) & mask, distance++)
+    {
+        IndexSlot_t *resident = &index->slots[slot];
+        if(resident->position == INDEX_EMPTY)
+        {
+            *resident = entry;
+            index->count++;
+            return;
+        }
+        if(resident->value == entry.value)
+        {
+            // only the new value can be present already, displaced ones are unique
+            size_t first = index_position(resident);
+            resident->position = (first < position ? first : position) | INDEX_DUPLICATED;
+            return;
+        }
+        size_t residentDistance = (slot - index_home(index, resident->value)) & mask;
+        if(residentDistance < distance)
+        {
+            IndexSlot_t swap = *resident;
+            *resident = entry;
+            entry = swap;
+            distance = residentDistance;
+        }
+    }
+}
+
+/*! Returns the slot of the \a value or NULL when it is not indexed. */
+static IndexSlot_t *index_slot(const Vector_Index_t *index, Vector_DataType_t value)
+{
+    size_t mask = index->capacity - 1;
+    size_t distance = 0;
+    for(size_t slot = index_home(index, value);; slot = (slot + 1) & mask, distance++)
+    {
+        IndexSlot_t *resident = &index->slots[slot];
+        if(resident->position == INDEX_EMPTY)
+        {
+            return NULL;
+        }
+        if(resident->value == value)
+        {
+            return resident;
+        }
+        if(((slot - index_home(index, resident->value)) & mask) < distance)
+        {
+            return NULL;  // the value would have displaced this resident
+        }
+    }
+}
+
+/*! Empties the \a slot and shifts the following entries of its probe sequence one slot back, so no
+ * tombstones are needed and the probe sequences stay as short as after an insertion.
+ */
+static void index_delete(Vector_Index_t *index, IndexSlot_t *slot)
+{
+    size_t mask = index->capacity - 1;
+    size_t hole = (size_t)(slot - index->slots);
+    for(;;)
+    {
+        size_t next = (hole + 1) & mask;
+        const IndexSlot_t *resident = &index->slots[next];
+        if(resident->position == INDEX_EMPTY || index_home(index, resident->value) == next)
+        {
+            break;
+        }
+        index->slots[hole] = *resident;
+        hole = next;
+    }
+    index->slots[hole].position = INDEX_EMPTY;
+    index->count--;
+}
+
+/*! Adds the items behind the covered ones. When the table cannot grow, the index is marked stale
+ * and false is returned.
+ */
+static bool index_catch_up(Vector_Index_t *index, const Vector_t *const vector)
+{
+    size_t itemCount = Vector_Length(vector);
+    for(size_t i = index->covered; i < itemCount; i++)
+    {
+        if(!index_reserve(index))
+        {
+            index->stale = true;
+            return false;
+        }
+        index_insert(index, vector->items[i], i);
+    }
+    index->covered = itemCount;
+    return true;
+}
+
+/*! Indexes all items again in a table sized for the current length of the vector. The table is
+ * emptied and reused while it fits the items and is at most 4 times bigger than needed, so removals
+ * do not reallocate it one by one. The index stays stale when a new table cannot be allocated.
+ */
+static bool index_rebuild(Vector_Index_t *index, const Vector_t *const vector)
+{
+    size_t itemCount = Vector_Length(vector);
+    size_t capacity = INDEX_MIN_CAPACITY;
+    while(capacity - capacity / 8 <= itemCount && capacity <= SIZE_MAX / 4 / sizeof(IndexSlot_t))
+    {
+        capacity *= 2;
+    }
+
+    index->covered = 0;
+    index->stale = true;
+    if(index->slots && index->capacity >= capacity && index->capacity / 4 <= capacity)
+    {
+        for(size_t i = 0; i < index->capacity; i++)
+        {
+            index->slots[i].position = INDEX_EMPTY;
+        }
+        index->count = 0;
+    }
+    else
+    {
+        // the old table is released first, so the rebuild never needs both of them
+        index->allocator->free(index->allocator->context,
+                               index->slots,
+                               index->capacity * sizeof(IndexSlot_t));
+        index->slots = NULL;
+        index->capacity = 0;
+        index->count = 0;
+        if(!index_resize(index, capacity))
+        {
+            return false;
+        }
+    }
+    index->stale = false;
+    return index_catch_up(index, vector);
+}
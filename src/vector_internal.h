@@ -0,0 +1,98 @@
+/*!
+ * \file       vector_internal.h
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Private helpers shared by the source files of the vector module
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef __VECTOR_INTERNAL_H
+#define __VECTOR_INTERNAL_H
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+
+/* Exported types --------------------------------------------------------------------------------*/
+/* Exported macros -------------------------------------------------------------------------------*/
+/* Exported variables ----------------------------------------------------------------------------*/
+/* Exported functions declarations ---------------------------------------------------------------*/
+/*! Initializes all fields of an empty \a vector that owns the block of \a items of \a size items.
+ * It is shared by all constructors, including the ones of vectors embedded in other structures.
+ */
+void vector_init(Vector_t *const vector,
+                 Vector_DataType_t *items,
+                 size_t size,
+                 const Vector_Growth_t *const growth,
+                 const Vector_Allocator_t *const allocator);
+
+/*! Makes sure there is room for \a count more items in the \a vector, expanding it at most once
+ * according to its growth policy. The \a vector is not modified when the expansion fails.
+ */
+bool vector_ensure_capacity(Vector_t *const vector, size_t count);
+
+/*! Returns the allocator of new vectors and temporary buffers derived from the \a vector, i.e. its
+ * own allocator unless that one cannot allocate blocks (see \ref Vector_Allocator_t.alloc), in
+ * which case \ref Vector_DefaultAllocator is returned.
+ */
+const Vector_Allocator_t *vector_derived_allocator(const Vector_t *const vector);
+
+/*! Updates \ref Vector_t.sorted and \ref Vector_t.index after \a count items were written from the
+ * \a position. Only the boundaries of the written block are checked unless \a scan is set, in which
+ * case the block itself is verified too. The flag is never set back by this function.
+ */
+void vector_track_sorted(Vector_t *const vector, size_t position, size_t count, bool scan);
+
+/*! Returns index of the first item that is not less than \a value in a sorted array, \a count is
+ * returned when there is none. The loop has no data dependent branch, the comparison compiles to a
+ * conditional move.
+ */
+size_t vector_lower_bound(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+
+/*! Returns index of the first item that is greater than \a value in a sorted array, \a count is
+ * returned when there is none.
+ */
+size_t vector_upper_bound(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+
+/*! Updates the index of the \a vector after items were written from the \a position to its end.
+ * Items appended behind the indexed ones are added, other writes rebuild the index. Nothing is done
+ * when the \a vector has no index.
+ */
+void vector_index_written(Vector_t *const vector, size_t position);
+
+/*! Updates the index of the \a vector after the item at the \a position was overwritten, its
+ * previous value was the \a old_value. The entries of both values are updated in place.
+ */
+void vector_index_replaced(Vector_t *const vector, size_t position, Vector_DataType_t old_value);
+
+/*! Updates the index of the \a vector after it was shortened from the \a old_length, the removed
+ * items must still be stored behind \ref Vector_t.next. Only their entries are deleted.
+ */
+void vector_index_truncated(Vector_t *const vector, size_t old_length);
+
+/*! Indexes all items of the \a vector again after they were removed or moved, nothing is done when
+ * the \a vector has no index.
+ */
+void vector_index_rebuild(Vector_t *const vector);
+
+/*! Builds the index of the \a vector if it is stale or does not cover all items, e.g. before the
+ * vector is shared with readers. The index is dropped when it cannot be built.
+ */
+void vector_index_refresh(Vector_t *const vector);
+
+/*! Looks the \a value up in the index of the \a vector without modifying it, so it can be called by
+ * concurrent readers. The \a position is set to the first occurrence of the \a value or to SIZE_MAX
+ * when there is none.
+ *
+ * \return  False when the \a vector has no index or the index is stale or does not cover all items,
+ * the \a vector must be searched directly then.
+ */
+bool vector_index_find(const Vector_t *const vector,
+                       Vector_DataType_t value,
+                       size_t *const position);
+
+#endif  //__VECTOR_INTERNAL_H
@@ -0,0 +1,328 @@
+/*!
+ * \file       vector_io.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Binary serialization of vectors
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include "vector_internal.h"
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Identification of the file format. */
+#define IO_MAGIC "VECB"
+
+/*! Version of the format written by \ref Vector_Save, the readers accept only this one. */
+#define IO_VERSION 1
+
+/*! Size of the header: magic (4), version (2), item size (1), flags (1) and length (8). */
+#define IO_HEADER_SIZE 16
+
+/*! Size of the trailer with the checksum. */
+#define IO_TRAILER_SIZE 8
+
+/*! Modulus of the Fletcher checksum. */
+#define IO_CHECKSUM_MOD 0xFFFFFFFFu
+
+/*! Number of items after which the checksum sums are reduced, the sums cannot overflow before. */
+#define IO_CHECKSUM_BLOCK 4096
+
+/*! Number of 32 bit words of the checksum per item, a narrower item is one word. */
+#define IO_CHECKSUM_WORDS ((sizeof(Vector_DataType_t) + 3) / 4)
+
+/*! Number of items converted at once when the byte order of the host is not little endian. */
+#define IO_SWAP_BLOCK 512
+
+/*! Number of items \ref Vector_Load reads at first from a stream whose size is unknown, every next
+ * chunk is as long as all items read before, so the memory grows only with the data really read.
+ */
+#define IO_LOAD_CHUNK 65536
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static bool io_little_endian(void);
+static Vector_DataType_t io_swap(Vector_DataType_t value);
+static void io_checksum(Vector_Checksum_t *state, const Vector_DataType_t *items, size_t count);
+static uint64_t io_checksum_value(const Vector_Checksum_t *state);
+static void io_put_le(unsigned char *bytes, uint64_t value, size_t size);
+static uint64_t io_get_le(const unsigned char *bytes, size_t size);
+static long io_bytes_left(FILE *stream);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+bool Vector_Save(const Vector_t *const vector, FILE *const stream)
+{
+    if(vector == NULL || stream == NULL)
+    {
+        return false;
+    }
+
+    size_t itemCount = Vector_Length(vector);
+    unsigned char header[IO_HEADER_SIZE];
+    memcpy(header, IO_MAGIC, 4);
+    io_put_le(header + 4, IO_VERSION, 2);
+    header[6] = sizeof(Vector_DataType_t);
+    header[7] = 0;
+    io_put_le(header + 8, itemCount, 8);
+    if(fwrite(header, 1, sizeof(header), stream) != sizeof(header))
+    {
+        return false;
+    }
+
+    Vector_Checksum_t checksum = {0};
+    io_checksum(&checksum, vector->items, itemCount);
+    if(io_little_endian())
+    {
+        // the items are written as a single block straight from the vector
+        if(itemCount > 0
+           && fwrite(vector->items, sizeof(Vector_DataType_t), itemCount, stream) != itemCount)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Vector_DataType_t buffer[IO_SWAP_BLOCK];
+        for(size_t i = 0; i < itemCount; i += IO_SWAP_BLOCK)
+        {
+            size_t count = itemCount - i < IO_SWAP_BLOCK ? itemCount - i : IO_SWAP_BLOCK;
+            for(size_t j = 0; j < count; j++)
+            {
+                buffer[j] = io_swap(vector->items[i + j]);
+            }
+            if(fwrite(buffer, sizeof(Vector_DataType_t), count, stream) != count)
+            {
+                return false;
+            }
+        }
+    }
+
+    unsigned char trailer[IO_TRAILER_SIZE];
+    io_put_le(trailer, io_checksum_value(&checksum), 8);
+    return fwrite(trailer, 1, sizeof(trailer), stream) == sizeof(trailer);
+}
+
+Vector_t *Vector_Load(FILE *const stream, size_t alloc_step)
+{
+    Vector_Reader_t reader;
+    if(!Vector_ReaderOpen(&reader, stream) || reader.remaining != (size_t)reader.remaining)
+    {
+        return NULL;
+    }
+
+    // the length was checked against the size of a seekable stream, others are read in chunks
+    size_t chunk = io_bytes_left(stream) >= 0 || reader.remaining < IO_LOAD_CHUNK
+                   ? (size_t)reader.remaining : IO_LOAD_CHUNK;
+    Vector_t *v = Vector_Create(chunk > 0 ? chunk : 1, alloc_step);
+    if(v == NULL)
+    {
+        return NULL;
+    }
+    while(!Vector_ReaderFinished(&reader))
+    {
+        size_t itemCount = Vector_Length(v);
+        if(itemCount > chunk)
+        {
+            chunk = itemCount;
+        }
+        if(chunk > reader.remaining)
+        {
+            chunk = (size_t)reader.remaining;
+        }
+        if(!Vector_Reserve(v, itemCount + chunk)
+           || Vector_ReaderRead(&reader, v, chunk) == SIZE_MAX)
+        {
+            Vector_Destroy(&v);
+            break;
+        }
+    }
+    return v;
+}
+
+bool Vector_ReaderOpen(Vector_Reader_t *const reader, FILE *const stream)
+{
+    if(reader == NULL || stream == NULL)
+    {
+        return false;
+    }
+
+    unsigned char header[IO_HEADER_SIZE];
+    if(fread(header, 1, sizeof(header), stream) != sizeof(header)
+       || memcmp(header, IO_MAGIC, 4) != 0 || io_get_le(header + 4, 2) != IO_VERSION
+       || header[6] != sizeof(Vector_DataType_t))
+    {
+        return false;
+    }
+
+    // a seekable stream must hold all items and the trailer, so a corrupted length is rejected
+    // before anything is allocated for it
+    uint64_t length = io_get_le(header + 8, 8);
+    long left = io_bytes_left(stream);
+    if(left >= 0
+       && (length > (uint64_t)left / sizeof(Vector_DataType_t)
+           || length * sizeof(Vector_DataType_t) + IO_TRAILER_SIZE > (uint64_t)left))
+    {
+        return false;
+    }
+
+    *reader = (Vector_Reader_t){
+        .stream = stream,
+        .length = length,
+    };
+    reader->remaining = reader->length;
+    return true;
+}
+
+size_t Vector_ReaderRead(Vector_Reader_t *const reader, Vector_t *const vector, size_t max_items)
+{
+    if(reader == NULL || vector == NULL)
+    {
+        return SIZE_MAX;
+    }
+    if(Vector_ReaderFinished(reader))
+    {
+        return 0;
+    }
+    if(reader->stream == NULL || (max_items == 0 && reader->remaining > 0))
+    {
+        return SIZE_MAX;
+    }
+
+    size_t count = reader->remaining < max_items ? (size_t)reader->remaining : max_items;
+    if(!vector_ensure_capacity(vector, count))
+    {
+        return SIZE_MAX;
+    }
+
+    // the items are read straight into the vector, they are not buffered anywhere else
+    Vector_DataType_t *items = vector->next;
+    if(count > 0 && fread(items, sizeof(Vector_DataType_t), count, reader->stream) != count)
+    {
+        reader->stream = NULL;
+        return SIZE_MAX;
+    }
+    if(!io_little_endian())
+    {
+        for(size_t i = 0; i < count; i++)
+        {
+            items[i] = io_swap(items[i]);
+        }
+    }
+    io_checksum(&reader->checksum, items, count);
+
+    // the reader stays unfinished when the checksum does not match
+    if(reader->remaining == count)
+    {
+        unsigned char trailer[IO_TRAILER_SIZE];
+        bool valid = fread(trailer, 1, sizeof(trailer), reader->stream) == sizeof(trailer)
+                     && io_get_le(trailer, 8) == io_checksum_value(&reader->checksum);
+        reader->stream = NULL;
+        if(!valid)
+        {
+            return SIZE_MAX;
+        }
+    }
+    reader->remaining -= count;
+
+    size_t appendedAt = Vector_Length(vector);
+    vector->next += count;
+    vector_track_sorted(vector, appendedAt, count, true);
+    return count;
+}
+
+bool Vector_ReaderFinished(const Vector_Reader_t *const reader)
+{
+    return reader && reader->stream == NULL && reader->remaining == 0;
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+static bool io_little_endian(void)
+{
+    const uint16_t probe = 1;
+    return *(const unsigned char *)&probe == 1;
+}
+
+static Vector_DataType_t io_swap(Vector_DataType_t value)
+{
+    Vector_DataType_t swapped = 0;
+    for(size_t i = 0; i < sizeof(Vector_DataType_t); i++)
+    {
+        swapped = (swapped << 8) | ((value >> (8 * i)) & 0xFF);
+    }
+    return swapped;
+}
+
+/*! Adds the items to the Fletcher-64 checksum of the \a state. The checksum is computed over the 32
+ * bit words of the values (the low one first), so it does not depend on the byte order of the
+ * host. The sums are reduced once per \ref IO_CHECKSUM_BLOCK items only.
+ */
+static void io_checksum(Vector_Checksum_t *state, const Vector_DataType_t *items, size_t count)
+{
+    uint64_t sum1 = state->sum1, sum2 = state->sum2;
+    while(count > 0)
+    {
+        size_t block = count < IO_CHECKSUM_BLOCK ? count : IO_CHECKSUM_BLOCK;
+        for(size_t i = 0; i < block; i++)
+        {
+            for(size_t word = 0; word < IO_CHECKSUM_WORDS; word++)
+            {
+                sum1 += (uint32_t)((uint64_t)items[i] >> (32 * word));
+                sum2 += sum1;
+            }
+        }
+        sum1 %= IO_CHECKSUM_MOD;
+        sum2 %= IO_CHECKSUM_MOD;
+        items += block;
+        count -= block;
+    }
+    state->sum1 = sum1;
+    state->sum2 = sum2;
+}
+
+static uint64_t io_checksum_value(const Vector_Checksum_t *state)
+{
+    return (state->sum2 << 32) | state->sum1;
+}
+
+static void io_put_le(unsigned char *bytes, uint64_t value, size_t size)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/*! Returns the number of bytes from the current position of the \a stream to its end or -1 when
+ * the \a stream is not seekable (e.g. a pipe). The position is not changed.
+ */
+static long io_bytes_left(FILE *stream)
+{
+    long position = ftell(stream);
+    if(position < 0 || fseek(stream, 0, SEEK_END) != 0)
+    {
+        return -1;
+    }
+    long end = ftell(stream);
+    if(fseek(stream, position, SEEK_SET) != 0)
+    {
+        return -1;
+    }
+    return end >= position ? end - position : -1;
+}
+
+static uint64_t io_get_le(const unsigned char *bytes, size_t size)
+{
+    uint64_t value = 0;
+    for(size_t i = 0; i < size; i++)
+    {
+        value |= (uint64_t)bytes[i] << (8 * i);
+    }
+    return value;
+}
@@ -0,0 +1,404 @@
+/*!
+ * \file       vector_kernels.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      SIMD search kernels with runtime CPU dispatch for the vector module
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector_kernels.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+/* Private macros --------------------------------------------------------------------------------*/
+#if !defined(VECTOR_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+  #define VECTOR_KERNELS_X86 1
+  #include <immintrin.h>
+#else
+  #define VECTOR_KERNELS_X86 0
+#endif
+
+/* Private types ---------------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static void kernels_detect(void);
+static size_t find_first_scalar(const Vector_DataType_t *items,
+                                size_t count,
+                                Vector_DataType_t value);
+static size_t find_last_scalar(const Vector_DataType_t *items,
+                               size_t count,
+                               Vector_DataType_t value);
+static size_t count_scalar(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+
+#if VECTOR_KERNELS_X86
+static size_t find_first_sse41(const Vector_DataType_t *items,
+                               size_t count,
+                               Vector_DataType_t value);
+static size_t find_last_sse41(const Vector_DataType_t *items,
+                              size_t count,
+                              Vector_DataType_t value);
+static size_t count_sse41(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+static size_t find_first_avx2(const Vector_DataType_t *items,
+                              size_t count,
+                              Vector_DataType_t value);
+static size_t find_last_avx2(const Vector_DataType_t *items,
+                             size_t count,
+                             Vector_DataType_t value);
+static size_t count_avx2(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+static size_t find_first_avx512(const Vector_DataType_t *items,
+                                size_t count,
+                                Vector_DataType_t value);
+static size_t find_last_avx512(const Vector_DataType_t *items,
+                               size_t count,
+                               Vector_DataType_t value);
+static size_t count_avx512(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+#endif
+
+/* Private variables -----------------------------------------------------------------------------*/
+static const VectorKernels_t kernels_scalar = {find_first_scalar, find_last_scalar, count_scalar};
+
+#if VECTOR_KERNELS_X86
+static const VectorKernels_t kernels_sse41 = {find_first_sse41, find_last_sse41, count_sse41};
+static const VectorKernels_t kernels_avx2 = {find_first_avx2, find_last_avx2, count_avx2};
+static const VectorKernels_t kernels_avx512 = {find_first_avx512, find_last_avx512, count_avx512};
+#endif
+
+/*! Kernels supported by the CPU from the scalar ones to the widest ones, filled once by \ref
+ * kernels_detect.
+ */
+static const VectorKernels_t *kernels_supported[4];
+
+/*! Number of the valid items of \ref kernels_supported. */
+static size_t kernels_supported_count = 0;
+
+/*! Guards the detection, concurrent first calls wait until it is done. */
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+const VectorKernels_t *vector_kernels_get(void)
+{
+    pthread_once(&kernels_once, kernels_detect);
+    return kernels_supported[kernels_supported_count - 1];
+}
+
+const VectorKernels_t *vector_kernels_supported(size_t index)
+{
+    pthread_once(&kernels_once, kernels_detect);
+    return index < kernels_supported_count ? kernels_supported[index] : NULL;
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Lists the kernels the CPU can run, it is called exactly once by pthread_once. */
+static void kernels_detect(void)
+{
+    kernels_supported[kernels_supported_count++] = &kernels_scalar;
+#if VECTOR_KERNELS_X86
+    // the SIMD kernels compare 64-bit lanes
+    if(sizeof(Vector_DataType_t) == sizeof(uint64_t))
+    {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("sse4.1"))
+        {
+            kernels_supported[kernels_supported_count++] = &kernels_sse41;
+        }
+        if(__builtin_cpu_supports("avx2"))
+        {
+            kernels_supported[kernels_supported_count++] = &kernels_avx2;
+        }
+        if(__builtin_cpu_supports("avx512f"))
+        {
+            kernels_supported[kernels_supported_count++] = &kernels_avx512;
+        }
+    }
+#endif
+}
+
+static size_t find_first_scalar(const Vector_DataType_t *items,
+                                size_t count,
+                                Vector_DataType_t value)
+{
+    for(size_t i = 0; i < count; i++)
+    {
+        if(items[i] == value)
+        {
+            return i;
+        }
+    }
+    return count;
+}
+
+static size_t find_last_scalar(const Vector_DataType_t *items,
+                               size_t count,
+                               Vector_DataType_t value)
+{
+    for(size_t i = count; i > 0; i--)
+    {
+        if(items[i - 1] == value)
+        {
+            return i - 1;
+        }
+    }
+    return count;
+}
+
+static size_t count_scalar(const Vector_DataType_t *items, size_t count, Vector_DataType_t value)
+{
+    size_t found = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        found += items[i] == value;
+    }
+    return found;
+}
+
+#if VECTOR_KERNELS_X86
+/* SSE4.1: 2 lanes per compare -------------------------------------------------------------------*/
+__attribute__((target("sse4.1"))) static size_t find_first_sse41(const Vector_DataType_t *items,
+                                                                 size_t count,
+                                                                 Vector_DataType_t value)
+{
+    const __m128i needle = _mm_set1_epi64x((long long)value);
+    size_t i = 0;
+
+    for(; i + 2 <= count; i += 2)
+    {
+        __m128i eq = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(items + i)), needle);
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(eq));
+        if(mask)
+        {
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+    }
+    for(; i < count; i++)
+    {
+        if(items[i] == value)
+        {
+            return i;
+        }
+    }
+    return count;
+}
+
+__attribute__((target("sse4.1"))) static size_t find_last_sse41(const Vector_DataType_t *items,
+                                                                size_t count,
+                                                                Vector_DataType_t value)
+{
+    const __m128i needle = _mm_set1_epi64x((long long)value);
+    size_t i = count;
+
+    for(; i >= 2; i -= 2)
+    {
+        __m128i eq = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(items + i - 2)), needle);
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(eq));
+        if(mask)
+        {
+            return i - 2 + (size_t)(31 - __builtin_clz((unsigned)mask));
+        }
+    }
+    if(i == 1 && items[0] == value)
+    {
+        return 0;
+    }
+    return count;
+}
+
+__attribute__((target("sse4.1"))) static size_t count_sse41(const Vector_DataType_t *items,
+                                                            size_t count,
+                                                            Vector_DataType_t value)
+{
+    const __m128i needle = _mm_set1_epi64x((long long)value);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    // equal lanes are all ones (-1), subtracting them counts the matches per lane
+    for(; i + 2 <= count; i += 2)
+    {
+        acc = _mm_sub_epi64(acc,
+                            _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i *)(items + i)), needle));
+    }
+    size_t found = (size_t)_mm_cvtsi128_si64(acc) + (size_t)_mm_extract_epi64(acc, 1);
+    for(; i < count; i++)
+    {
+        found += items[i] == value;
+    }
+    return found;
+}
+
+/* AVX2: 4 lanes per compare, 16 items per iteration ---------------------------------------------*/
+__attribute__((target("avx2"))) static size_t find_first_avx2(const Vector_DataType_t *items,
+                                                              size_t count,
+                                                              Vector_DataType_t value)
+{
+    const __m256i needle = _mm256_set1_epi64x((long long)value);
+    size_t i = 0;
+
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i eq0 = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(items + i)), needle);
+        __m256i eq1 =
+          _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(items + i + 4)), needle);
+        __m256i eq2 =
+          _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(items + i + 8)), needle);
+        __m256i eq3 =
+          _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(items + i + 12)), needle);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+        if(!_mm256_testz_si256(any, any))
+        {
+            unsigned mask = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(eq0))
+                            | (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(eq1)) << 4
+                            | (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(eq2)) << 8
+                            | (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(eq3)) << 12;
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+    for(; i + 4 <= count; i += 4)
+    {
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(items + i)), needle);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        if(mask)
+        {
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+    }
+    for(; i < count; i++)
+    {
+        if(items[i] == value)
+        {
+            return i;
+        }
+    }
+    return count;
+}
+
+__attribute__((target("avx2"))) static size_t find_last_avx2(const Vector_DataType_t *items,
+                                                             size_t count,
+                                                             Vector_DataType_t value)
+{
+    const __m256i needle = _mm256_set1_epi64x((long long)value);
+    size_t i = count;
+
+    for(; i >= 4; i -= 4)
+    {
+        __m256i eq =
+          _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(items + i - 4)), needle);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        if(mask)
+        {
+            return i - 4 + (size_t)(31 - __builtin_clz((unsigned)mask));
+        }
+    }
+    for(; i > 0; i--)
+    {
+        if(items[i - 1] == value)
+        {
+            return i - 1;
+        }
+    }
+    return count;
+}
+
+__attribute__((target("avx2"))) static size_t count_avx2(const Vector_DataType_t *items,
+                                                         size_t count,
+                                                         Vector_DataType_t value)
+{
+    const __m256i needle = _mm256_set1_epi64x((long long)value);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for(; i + 4 <= count; i += 4)
+    {
+        acc = _mm256_sub_epi64(
+          acc, _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(items + i)), needle));
+    }
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    size_t found = (size_t)_mm_cvtsi128_si64(half) + (size_t)_mm_extract_epi64(half, 1);
+    for(; i < count; i++)
+    {
+        found += items[i] == value;
+    }
+    return found;
+}
+
+/* AVX-512F: 8 lanes per compare -----------------------------------------------------------------*/
+__attribute__((target("avx512f"))) static size_t find_first_avx512(const Vector_DataType_t *items,
+                                                                   size_t count,
+                                                                   Vector_DataType_t value)
+{
+    const __m512i needle = _mm512_set1_epi64((long long)value);
+    size_t i = 0;
+
+    for(; i + 8 <= count; i += 8)
+    {
+        __mmask8 mask = _mm512_cmpeq_epu64_mask(_mm512_loadu_si512(items + i), needle);
+        if(mask)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+    if(i < count)
+    {
+        // the remaining lanes are loaded with a mask, so nothing behind the array is read
+        __mmask8 tail = (__mmask8)((1u << (count - i)) - 1u);
+        __mmask8 mask =
+          _mm512_mask_cmpeq_epu64_mask(tail, _mm512_maskz_loadu_epi64(tail, items + i), needle);
+        if(mask)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+    return count;
+}
+
+__attribute__((target("avx512f"))) static size_t find_last_avx512(const Vector_DataType_t *items,
+                                                                  size_t count,
+                                                                  Vector_DataType_t value)
+{
+    const __m512i needle = _mm512_set1_epi64((long long)value);
+    size_t i = count;
+
+    for(; i >= 8; i -= 8)
+    {
+        __mmask8 mask = _mm512_cmpeq_epu64_mask(_mm512_loadu_si512(items + i - 8), needle);
+        if(mask)
+        {
+            return i - 8 + (size_t)(31 - __builtin_clz(mask));
+        }
+    }
+    if(i > 0)
+    {
+        __mmask8 head = (__mmask8)((1u << i) - 1u);
+        __mmask8 mask =
+          _mm512_mask_cmpeq_epu64_mask(head, _mm512_maskz_loadu_epi64(head, items), needle);
+        if(mask)
+        {
+            return (size_t)(31 - __builtin_clz(mask));
+        }
+    }
+    return count;
+}
+
+__attribute__((target("avx512f"))) static size_t count_avx512(const Vector_DataType_t *items,
+                                                              size_t count,
+                                                              Vector_DataType_t value)
+{
+    const __m512i needle = _mm512_set1_epi64((long long)value);
+    size_t found = 0;
+    size_t i = 0;
+
+    for(; i + 8 <= count; i += 8)
+    {
+        found += (size_t)__builtin_popcount(
+          _mm512_cmpeq_epu64_mask(_mm512_loadu_si512(items + i), needle));
+    }
+    for(; i < count; i++)
+    {
+        found += items[i] == value;
+    }
+    return found;
+}
+#endif
@@ -0,0 +1,52 @@
+/*!
+ * \file       vector_kernels.h
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Private header of the search kernels used by the vector module
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef __VECTOR_KERNELS_H
+#define __VECTOR_KERNELS_H
+
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+
+/* Exported types --------------------------------------------------------------------------------*/
+/*! Table of the search kernels selected for the running CPU. All kernels work on a plain array of
+ * \a count items and never read behind it.
+ */
+typedef struct {
+  /*! Returns index of the first item equal to \a value or \a count when there is none. */
+  size_t (*find_first)(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+
+  /*! Returns index of the last item equal to \a value or \a count when there is none. */
+  size_t (*find_last)(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+
+  /*! Returns number of items equal to \a value. */
+  size_t (*count)(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+} VectorKernels_t;
+
+/* Exported macros -------------------------------------------------------------------------------*/
+/* Exported variables ----------------------------------------------------------------------------*/
+/* Exported functions declarations ---------------------------------------------------------------*/
+/*! Returns the kernels for the widest instruction set supported by the CPU. The selection is done
+ * on the first call, the portable scalar kernels are used when no SIMD extension is available or
+ * when the library is built with VECTOR_NO_SIMD.
+ */
+const VectorKernels_t *vector_kernels_get(void);
+
+/*! Returns the kernels with the \a index in the list of the kernels the CPU supports, the list
+ * starts by the scalar kernels and ends by the ones returned by \ref vector_kernels_get. It lets
+ * the tests run every implementation and not only the selected one.
+ *
+ * \return  Pointer to the kernels or NULL when the \a index is behind the end of the list.
+ */
+const VectorKernels_t *vector_kernels_supported(size_t index);
+
+#endif  //__VECTOR_KERNELS_H
@@ -0,0 +1,313 @@
+/*!
+ * \file       vector_mapped.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Vectors stored in memory mapped files
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#if defined(__linux__)
+  #define _GNU_SOURCE  // mremap
+#endif
+#include "vector.h"
+#include "vector_internal.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <string.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define VECTOR_MAPPED_SUPPORTED 1
+#endif
+
+#ifdef VECTOR_MAPPED_SUPPORTED
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Header stored at the beginning of the file, the items follow it. */
+typedef struct {
+  /*! \ref MAPPED_MAGIC */
+  char magic[8];
+
+  /*! Size of one item in bytes, files of a different \ref Vector_DataType_t are rejected. */
+  uint64_t item_size;
+
+  /*! Number of items stored in the file. */
+  uint64_t length;
+
+  /*! Reserved for future use, it is zero. */
+  uint64_t reserved;
+} MappedHeader_t;
+
+/*! Mapped vector together with its allocator, the vector is the first member, so a pointer to it
+ * is a pointer to the whole structure.
+ */
+typedef struct {
+  Vector_t vector;
+
+  /*! Allocator of the vector, its context points to this structure. */
+  Vector_Allocator_t allocator;
+
+  /*! Descriptor of the mapped file. */
+  int fd;
+
+  /*! Changes are written to the file (the mapping is shared). */
+  bool writable;
+
+  /*! Start of the mapping, i.e. of the header, NULL when the file is not mapped. */
+  unsigned char *base;
+
+  /*! Number of mapped bytes including the header. */
+  size_t mapped;
+} MappedVector_t;
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Identification of the file format. */
+#define MAPPED_MAGIC "VECMAP1"
+
+/*! Items start behind the header. */
+#define MAPPED_HEADER sizeof(MappedHeader_t)
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static void *mapped_realloc(void *context, void *ptr, size_t old_size, size_t new_size);
+static void mapped_free(void *context, void *ptr, size_t size);
+static bool mapped_map(MappedVector_t *mapped, size_t size);
+static bool mapped_write_length(MappedVector_t *mapped, size_t length);
+static bool mapped_truncate(MappedVector_t *mapped, size_t size);
+#endif
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+#ifdef VECTOR_MAPPED_SUPPORTED
+Vector_t *Vector_OpenMapped(const char *path, Vector_MapMode_t mode)
+{
+    if(path == NULL)
+    {
+        return NULL;
+    }
+
+    int flags = mode == VECTOR_MAP_READ_ONLY ? O_RDONLY
+                : mode == VECTOR_MAP_CREATE  ? O_RDWR | O_CREAT | O_TRUNC
+                                             : O_RDWR;
+    int fd = open(path, flags, 0644);
+    if(fd < 0)
+    {
+        return NULL;
+    }
+
+    MappedHeader_t header = {.magic = MAPPED_MAGIC, .item_size = sizeof(Vector_DataType_t)};
+    struct stat status;
+    bool valid;
+    if(mode == VECTOR_MAP_CREATE)
+    {
+        valid = pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header);
+        status.st_size = sizeof(header);
+    }
+    else
+    {
+        valid = fstat(fd, &status) == 0 && status.st_size >= (off_t)sizeof(header)
+                && pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)
+                && memcmp(header.magic, MAPPED_MAGIC, sizeof(header.magic)) == 0
+                && header.item_size == sizeof(Vector_DataType_t)
+                && header.length <= (status.st_size - sizeof(header)) / sizeof(Vector_DataType_t);
+    }
+
+    const Vector_Allocator_t *backend = &Vector_DefaultAllocator;
+    MappedVector_t *mapped = NULL;
+    if(valid)
+    {
+        mapped = backend->alloc(backend->context, sizeof(MappedVector_t));
+    }
+    if(mapped == NULL)
+    {
+        close(fd);
+        return NULL;
+    }
+    mapped->allocator = (Vector_Allocator_t){
+        .alloc = NULL,
+        .realloc = mapped_realloc,
+        .free = mapped_free,
+        .context = mapped,
+    };
+    mapped->fd = fd;
+    mapped->writable = mode != VECTOR_MAP_READ_ONLY;
+    mapped->base = NULL;
+    if(!mapped_map(mapped, (size_t)status.st_size))
+    {
+        close(fd);
+        backend->free(backend->context, mapped, sizeof(MappedVector_t));
+        return NULL;
+    }
+
+    Vector_t *v = &mapped->vector;
+    Vector_Growth_t growth = {
+        .policy = VECTOR_GROWTH_GEOMETRIC,
+        .alloc_step = 0,
+        .factor = VECTOR_GROWTH_DEFAULT_FACTOR,
+        .threshold = 0,
+    };
+    vector_init(v,
+                (Vector_DataType_t *)(mapped->base + MAPPED_HEADER),
+                (mapped->mapped - MAPPED_HEADER) / sizeof(Vector_DataType_t),
+                &growth,
+                &mapped->allocator);
+    v->next = v->items + header.length;
+    vector_track_sorted(v, 0, header.length, true);
+    return v;
+}
+
+bool Vector_SyncMapped(Vector_t *const vector)
+{
+    if(vector == NULL || vector->allocator->free != mapped_free)
+    {
+        return false;
+    }
+
+    MappedVector_t *mapped = vector->allocator->context;
+    if(!mapped->writable)
+    {
+        return false;
+    }
+    size_t itemCount = vector->items ? Vector_Length(vector) : 0;
+    if(!mapped_write_length(mapped, itemCount))
+    {
+        return false;
+    }
+    if(mapped->base && msync(mapped->base, mapped->mapped, MS_SYNC) != 0)
+    {
+        return false;
+    }
+    return fsync(mapped->fd) == 0;
+}
+#else
+Vector_t *Vector_OpenMapped(const char *path, Vector_MapMode_t mode)
+{
+    (void)path;
+    (void)mode;
+    return NULL;
+}
+
+bool Vector_SyncMapped(Vector_t *const vector)
+{
+    (void)vector;
+    return false;
+}
+#endif
+
+#ifdef VECTOR_MAPPED_SUPPORTED
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Resizes the file and its mapping, \a ptr is \ref Vector_t.items or NULL after \ref Vector_Clear.
+ * The file is expanded before the mapping and shrunk after it, so no mapped page is ever behind the
+ * end of the file. Read only vectors cannot be resized.
+ */
+static void *mapped_realloc(void *context, void *ptr, size_t old_size, size_t new_size)
+{
+    MappedVector_t *mapped = context;
+    (void)ptr;
+    (void)old_size;
+    if(!mapped->writable || new_size > SIZE_MAX - MAPPED_HEADER)
+    {
+        return NULL;
+    }
+
+    size_t size = MAPPED_HEADER + new_size;
+    if(mapped->base == NULL || size > mapped->mapped)
+    {
+        if(!mapped_truncate(mapped, size))
+        {
+            return NULL;
+        }
+    }
+    if(mapped->base == NULL)
+    {
+        return mapped_map(mapped, size) ? mapped->base + MAPPED_HEADER : NULL;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    unsigned char *base = mremap(mapped->base, mapped->mapped, size, MREMAP_MAYMOVE);
+    if(base == MAP_FAILED)
+    {
+        return NULL;
+    }
+#else
+    unsigned char *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->fd, 0);
+    if(base == MAP_FAILED)
+    {
+        return NULL;
+    }
+    munmap(mapped->base, mapped->mapped);
+#endif
+    if(size < mapped->mapped)
+    {
+        mapped_truncate(mapped, size);  // a failure only leaves unused space at the end of the file
+    }
+    mapped->base = base;
+    mapped->mapped = size;
+    return base + MAPPED_HEADER;
+}
+
+/*! Releases the items or the vector structure. The length is stored to the header and the file is
+ * cut to it when the items are released, which happens before the vector structure is released by
+ * \ref Vector_Destroy. \ref Vector_Clear releases the items of an emptied vector, so its file is
+ * emptied right away.
+ */
+static void mapped_free(void *context, void *ptr, size_t size)
+{
+    MappedVector_t *mapped = context;
+    (void)size;
+    if(ptr == NULL)
+    {
+        return;
+    }
+
+    if(ptr == &mapped->vector)
+    {
+        close(mapped->fd);
+        const Vector_Allocator_t *backend = &Vector_DefaultAllocator;
+        backend->free(backend->context, mapped, sizeof(MappedVector_t));
+        return;
+    }
+
+    if(mapped->writable)
+    {
+        size_t itemCount = Vector_Length(&mapped->vector);
+        mapped_write_length(mapped, itemCount);
+        mapped_truncate(mapped, MAPPED_HEADER + itemCount * sizeof(Vector_DataType_t));
+    }
+    munmap(mapped->base, mapped->mapped);
+    mapped->base = NULL;
+    mapped->mapped = 0;
+}
+
+/*! Maps the first \a size bytes of the file. Read only files are mapped privately, so the items can
+ * still be modified in memory, e.g. sorted, without touching the file.
+ */
+static bool mapped_map(MappedVector_t *mapped, size_t size)
+{
+    int flags = mapped->writable ? MAP_SHARED : MAP_PRIVATE;
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, mapped->fd, 0);
+    if(base == MAP_FAILED)
+    {
+        return false;
+    }
+    mapped->base = base;
+    mapped->mapped = size;
+    return true;
+}
+
+static bool mapped_write_length(MappedVector_t *mapped, size_t length)
+{
+    uint64_t value = length;
+    return pwrite(mapped->fd, &value, sizeof(value), offsetof(MappedHeader_t, length))
+           == (ssize_t)sizeof(value);
+}
+
+static bool mapped_truncate(MappedVector_t *mapped, size_t size)
+{
+    return ftruncate(mapped->fd, (off_t)size) == 0;
+}
+#endif
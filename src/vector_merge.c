@@ -0,0 +1,310 @@
+/*!
+ * \file       vector_merge.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Merging of many sorted vectors and parallel merging of two sorted vectors
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include "vector_internal.h"
+#include <pthread.h>
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! State of the tournament over the merged inputs. */
+typedef struct {
+  /*! Current item of each input. */
+  const Vector_DataType_t **cursor;
+
+  /*! Pointer behind the last item of each input. */
+  const Vector_DataType_t **end;
+
+  /*! Loser of the match played in each internal node, the overall winner is stored at index 0. */
+  size_t *tree;
+
+  /*! Number of inputs (leaves of the tree). */
+  size_t k;
+} LoserTree_t;
+
+/*! Slice of the output of a parallel merge, it is merged independently of other slices. */
+typedef struct {
+  const Vector_DataType_t *a;
+  size_t aCount;
+  const Vector_DataType_t *b;
+  size_t bCount;
+
+  /*! Output position of the first merged item. */
+  Vector_DataType_t *out;
+} MergeSlice_t;
+
+/* Private macros --------------------------------------------------------------------------------*/
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static bool loser_tree_less(const LoserTree_t *tree, size_t a, size_t b);
+static size_t loser_tree_build(LoserTree_t *tree, size_t node);
+static void loser_tree_replay(LoserTree_t *tree, size_t winner);
+static size_t merge_co_rank(size_t k,
+                            const Vector_DataType_t *a,
+                            size_t aCount,
+                            const Vector_DataType_t *b,
+                            size_t bCount);
+static void merge_run(const MergeSlice_t *slice);
+static void *merge_thread(void *slice);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+bool Vector_MergeK(Vector_t *const result, Vector_t *const *const inputs, size_t k, bool dedup)
+{
+    // the cursors of the tree take 2 * k pointers, larger k cannot be allocated
+    if(result == NULL || (inputs == NULL && k > 0) || k > SIZE_MAX / (2 * sizeof(void *)))
+    {
+        return false;
+    }
+
+    size_t total = 0;
+    for(size_t i = 0; i < k; i++)
+    {
+        if(inputs[i] == NULL || !inputs[i]->sorted)
+        {
+            return false;
+        }
+        size_t itemCount = Vector_Length(inputs[i]);
+        if(SIZE_MAX - total < itemCount)
+        {
+            return false;
+        }
+        total += itemCount;
+    }
+    if(total == 0)
+    {
+        return true;
+    }
+
+    // the tree is allocated by the allocator of the result, so it shows in its statistics
+    const Vector_Allocator_t *allocator = vector_derived_allocator(result);
+    size_t cursorSize = 2 * k * sizeof(Vector_DataType_t *), treeSize = k * sizeof(size_t);
+    LoserTree_t tree = {.k = k};
+    tree.cursor = allocator->alloc(allocator->context, cursorSize);
+    tree.tree = allocator->alloc(allocator->context, treeSize);
+    if(tree.cursor == NULL || tree.tree == NULL || !vector_ensure_capacity(result, total))
+    {
+        allocator->free(allocator->context, tree.cursor, cursorSize);
+        allocator->free(allocator->context, tree.tree, treeSize);
+        return false;
+    }
+
+    // inputs are read after the expansion because the result may be one of them
+    tree.end = tree.cursor + k;
+    for(size_t i = 0; i < k; i++)
+    {
+        tree.cursor[i] = inputs[i]->items;
+        tree.end[i] = inputs[i]->items + Vector_Length(inputs[i]);
+    }
+    tree.tree[0] = k == 1 ? 0 : loser_tree_build(&tree, 1);
+
+    size_t appendedAt = Vector_Length(result);
+    Vector_DataType_t *out = result->next;
+    for(size_t merged = 0; merged < total; merged++)
+    {
+        size_t winner = tree.tree[0];
+        Vector_DataType_t value = *tree.cursor[winner]++;
+        if(!dedup || out == result->next || out[-1] != value)
+        {
+            *out++ = value;
+        }
+        loser_tree_replay(&tree, winner);
+    }
+    result->next = out;
+    vector_track_sorted(result, appendedAt, (size_t)(out - result->items) - appendedAt, false);
+
+    allocator->free(allocator->context, tree.cursor, cursorSize);
+    allocator->free(allocator->context, tree.tree, treeSize);
+    return true;
+}
+
+bool Vector_MergeParallel(Vector_t *const result,
+                          const Vector_t *const v1,
+                          const Vector_t *const v2,
+                          size_t threads)
+{
+    if(result == NULL || v1 == NULL || v2 == NULL || !v1->sorted || !v2->sorted)
+    {
+        return false;
+    }
+
+    size_t n1 = Vector_Length(v1), n2 = Vector_Length(v2);
+    if(SIZE_MAX - n1 < n2 || !vector_ensure_capacity(result, n1 + n2))
+    {
+        return false;
+    }
+    size_t total = n1 + n2;
+    if(threads > total / VECTOR_MERGE_PARALLEL_MIN)
+    {
+        threads = total / VECTOR_MERGE_PARALLEL_MIN;
+    }
+    if(threads == 0)
+    {
+        threads = 1;
+    }
+
+    // one block holds the slices followed by the handles of the worker threads
+    const Vector_Allocator_t *allocator = vector_derived_allocator(result);
+    size_t slicesSize = threads * (sizeof(MergeSlice_t) + sizeof(pthread_t));
+    MergeSlice_t *slices = threads > 1 ? allocator->alloc(allocator->context, slicesSize) : NULL;
+    if(slices == NULL)
+    {
+        threads = 1;
+    }
+
+    // items are read after the expansion because result may be one of the inputs
+    size_t appendedAt = Vector_Length(result);
+    MergeSlice_t single;
+    MergeSlice_t *slice = slices ? slices : &single;
+    size_t aStart = 0;
+    for(size_t t = 0; t < threads; t++)
+    {
+        size_t kStart = total / threads * t + (t < total % threads ? t : total % threads);
+        size_t kEnd = kStart + total / threads + (t < total % threads);
+        size_t aEnd = merge_co_rank(kEnd, v1->items, n1, v2->items, n2);
+        slice[t].a = v1->items + aStart;
+        slice[t].aCount = aEnd - aStart;
+        slice[t].b = v2->items + (kStart - aStart);
+        slice[t].bCount = (kEnd - aEnd) - (kStart - aStart);
+        slice[t].out = result->next + kStart;
+        aStart = aEnd;
+    }
+
+    // the calling thread merges the first slice, slices of failed threads are merged inline
+    pthread_t *workers = (pthread_t *)(slice + threads);
+    size_t running = 0;
+    for(size_t t = 1; t < threads; t++)
+    {
+        if(pthread_create(&workers[running], NULL, merge_thread, &slice[t]) == 0)
+        {
+            running++;
+        }
+        else
+        {
+            merge_run(&slice[t]);
+        }
+    }
+    merge_run(&slice[0]);
+    for(size_t t = 0; t < running; t++)
+    {
+        pthread_join(workers[t], NULL);
+    }
+
+    result->next += total;
+    vector_track_sorted(result, appendedAt, total, false);
+    allocator->free(allocator->context, slices, slicesSize);
+    return true;
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Tells whether the current item of the input \a a goes before the current item of the input \a b.
+ * Exhausted inputs lose every match and ties are decided by the input order, so the merge is
+ * stable.
+ */
+static bool loser_tree_less(const LoserTree_t *tree, size_t a, size_t b)
+{
+    if(tree->cursor[a] == tree->end[a])
+    {
+        return false;
+    }
+    if(tree->cursor[b] == tree->end[b])
+    {
+        return true;
+    }
+    return *tree->cursor[a] < *tree->cursor[b] || (*tree->cursor[a] == *tree->cursor[b] && a < b);
+}
+
+/*! Plays the initial matches of the subtree rooted at \a node and returns its winner. Nodes 1 to
+ * k-1 are internal, node k + i is the leaf of the input i.
+ */
+static size_t loser_tree_build(LoserTree_t *tree, size_t node)
+{
+    if(node >= tree->k)
+    {
+        return node - tree->k;
+    }
+
+    size_t left = loser_tree_build(tree, 2 * node);
+    size_t right = loser_tree_build(tree, 2 * node + 1);
+    if(loser_tree_less(tree, left, right))
+    {
+        tree->tree[node] = right;
+        return left;
+    }
+    tree->tree[node] = left;
+    return right;
+}
+
+/*! Replays the matches on the path from the leaf of the input \a winner, whose current item has
+ * just changed, to the root. Only log2(k) comparisons are needed to find the next winner.
+ */
+static void loser_tree_replay(LoserTree_t *tree, size_t winner)
+{
+    for(size_t node = (winner + tree->k) / 2; node > 0; node /= 2)
+    {
+        if(loser_tree_less(tree, tree->tree[node], winner))
+        {
+            size_t loser = winner;
+            winner = tree->tree[node];
+            tree->tree[node] = loser;
+        }
+    }
+    tree->tree[0] = winner;
+}
+
+/*! Returns how many items of \a a are among the first \a k items of the stable merge of \a a and \a
+ * b (co-rank). The remaining k - i items come from \a b. Equal items of \a a go first.
+ */
+static size_t merge_co_rank(size_t k,
+                            const Vector_DataType_t *a,
+                            size_t aCount,
+                            const Vector_DataType_t *b,
+                            size_t bCount)
+{
+    size_t low = k > bCount ? k - bCount : 0;
+    size_t high = k < aCount ? k : aCount;
+    while(low < high)
+    {
+        size_t i = low + (high - low) / 2;
+        // the i-th item of a is taken before the (k-i-1)-th item of b exactly when a[i] <= b[k-i-1]
+        if(a[i] <= b[k - i - 1])
+        {
+            low = i + 1;
+        }
+        else
+        {
+            high = i;
+        }
+    }
+    return low;
+}
+
+/*! Merges one slice sequentially. */
+static void merge_run(const MergeSlice_t *slice)
+{
+    const Vector_DataType_t *a = slice->a, *aEnd = slice->a + slice->aCount;
+    const Vector_DataType_t *b = slice->b, *bEnd = slice->b + slice->bCount;
+    Vector_DataType_t *out = slice->out;
+    while(a < aEnd && b < bEnd)
+    {
+        *out++ = *b < *a ? *b++ : *a++;
+    }
+    memcpy(out, a, (size_t)(aEnd - a) * sizeof(Vector_DataType_t));
+    out += aEnd - a;
+    memcpy(out, b, (size_t)(bEnd - b) * sizeof(Vector_DataType_t));
+}
+
+static void *merge_thread(void *slice)
+{
+    merge_run(slice);
+    return NULL;
+}
@@ -0,0 +1,464 @@
+/*!
+ * \file       vector_parallel.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Thread pool and parallel operations over vectors
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include "vector_internal.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Largest number of threads of the pool including the calling one. */
+#define PARALLEL_MAX_THREADS 64
+
+/*! Number of chunks per thread, more chunks than threads balance uneven progress of the threads. */
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+/*! Largest number of chunks of one job, the first chunk may be shorter because of the alignment. */
+#define PARALLEL_MAX_CHUNKS (PARALLEL_MAX_THREADS * PARALLEL_CHUNKS_PER_THREAD + 1)
+
+/*! Size of a cache line, chunk boundaries are aligned to it. */
+#define PARALLEL_CACHE_LINE 64
+
+/*! Number of items in one cache line. */
+#define PARALLEL_LINE_ITEMS (PARALLEL_CACHE_LINE / sizeof(Vector_DataType_t))
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Function processing the chunk with the \a index of the job described by the \a context. */
+typedef void (*ParallelTask_t)(void *context, size_t index);
+
+/*! Worker threads that run the chunks of one job at a time together with the calling thread. */
+typedef struct {
+  /*! Protects the description of the job and the counters below. */
+  pthread_mutex_t lock;
+
+  /*! Signals a new job to the workers. */
+  pthread_cond_t wake;
+
+  /*! Signals the calling thread that the last worker finished the job. */
+  pthread_cond_t finished;
+
+  /*! Serializes jobs submitted by different threads. */
+  pthread_mutex_t submit;
+
+  /*! Number of submitted jobs, a worker runs a job when it sees the number change. */
+  size_t generation;
+
+  /*! Current job. */
+  ParallelTask_t task;
+  void *context;
+  size_t count;
+
+  /*! Index of the next chunk to be taken by any thread. */
+  atomic_size_t next;
+
+  /*! Number of workers that did not finish the current job yet. */
+  size_t active;
+
+  /*! Number of worker threads, the calling thread is not counted. */
+  size_t workers;
+} ParallelPool_t;
+
+/*! Range of items split into chunks and the operation applied to them. Chunk 0 covers [start,
+ * first_end), chunk i covers the following \ref ParallelJob_t.chunk items, the last one ends at
+ * \ref ParallelJob_t.end.
+ */
+typedef struct {
+  const Vector_DataType_t *source;
+  Vector_DataType_t *target;
+  size_t start, first_end, end, chunk;
+
+  /*! Number of chunks. */
+  size_t count;
+
+  Vector_DataType_t value;
+  Vector_ReduceOp_t op;
+  Vector_Predicate_t predicate;
+  void *context;
+
+  /*! Results of the chunks of reductions. */
+  Vector_DataType_t *partials;
+  size_t *counts;
+} ParallelJob_t;
+
+/* Private variables -----------------------------------------------------------------------------*/
+static ParallelPool_t parallel_pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .finished = PTHREAD_COND_INITIALIZER,
+    .submit = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/*! The pool is started by the first parallel operation. */
+static pthread_once_t parallel_once = PTHREAD_ONCE_INIT;
+
+/*! Set in the workers and in a thread that runs a job, parallel operations called from a task (e.g.
+ * by a predicate of \ref Vector_CountIf) then run serially instead of waiting for the pool.
+ */
+static _Thread_local bool parallel_in_pool;
+
+/* Private function declarations -----------------------------------------------------------------*/
+static void parallel_pool_start(void);
+static void *parallel_worker(void *unused);
+static void parallel_work(ParallelPool_t *pool);
+static void parallel_run(ParallelTask_t task, void *context, size_t count);
+static void parallel_plan(ParallelJob_t *job,
+                          const Vector_DataType_t *aligned,
+                          size_t start,
+                          size_t end);
+static void parallel_chunk(const ParallelJob_t *job, size_t index, size_t *from, size_t *to);
+static void parallel_fill_task(void *context, size_t index);
+static void parallel_copy_task(void *context, size_t index);
+static void parallel_reduce_task(void *context, size_t index);
+static void parallel_count_task(void *context, size_t index);
+static Vector_DataType_t parallel_combine(Vector_ReduceOp_t op,
+                                          Vector_DataType_t a,
+                                          Vector_DataType_t b);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+void Vector_ParallelFill(Vector_t *const vector,
+                         Vector_DataType_t value,
+                         size_t start_position,
+                         size_t end_position)
+{
+    size_t itemCount = Vector_Length(vector);
+    if(vector == NULL || start_position >= itemCount)
+    {
+        return;
+    }
+
+    size_t end = end_position < itemCount ? end_position + 1 : itemCount;
+    ParallelJob_t job = {.target = vector->items, .value = value};
+    parallel_plan(&job, vector->items, start_position, end);
+    parallel_run(parallel_fill_task, &job, job.count);
+    vector_track_sorted(vector, start_position, end - start_position, false);
+}
+
+Vector_t *Vector_ParallelCopy(const Vector_t *const original)
+{
+    if(original == NULL)
+    {
+        return NULL;
+    }
+
+    Vector_Growth_t growth = {
+        .policy = original->growth_policy,
+        .alloc_step = original->alloc_step,
+        .factor = original->growth_factor,
+        .threshold = original->growth_threshold,
+    };
+    Vector_t *v = Vector_CreateWithAllocator(original->size,
+                                             &growth,
+                                             vector_derived_allocator(original));
+    size_t itemCount = Vector_Length(original);
+    if(v == NULL || !vector_ensure_capacity(v, itemCount))
+    {
+        Vector_Destroy(&v);
+        return NULL;
+    }
+
+    // the chunks are aligned in the copy, which is the memory that is written
+    ParallelJob_t job = {.source = original->items, .target = v->items};
+    parallel_plan(&job, v->items, 0, itemCount);
+    parallel_run(parallel_copy_task, &job, job.count);
+    v->next = v->items + itemCount;
+    v->sorted = original->sorted;
+    return v;
+}
+
+bool Vector_Reduce(const Vector_t *const vector,
+                   Vector_ReduceOp_t op,
+                   Vector_DataType_t *const result)
+{
+    if(vector == NULL || result == NULL || op > VECTOR_REDUCE_MAX)
+    {
+        return false;
+    }
+    size_t itemCount = Vector_Length(vector);
+    if(itemCount == 0)
+    {
+        if(op != VECTOR_REDUCE_SUM)
+        {
+            return false;
+        }
+        *result = 0;
+        return true;
+    }
+
+    Vector_DataType_t partials[PARALLEL_MAX_CHUNKS];
+    ParallelJob_t job = {.source = vector->items, .op = op, .partials = partials};
+    parallel_plan(&job, vector->items, 0, itemCount);
+    parallel_run(parallel_reduce_task, &job, job.count);
+    Vector_DataType_t value = partials[0];
+    for(size_t i = 1; i < job.count; i++)
+    {
+        value = parallel_combine(op, value, partials[i]);
+    }
+    *result = value;
+    return true;
+}
+
+size_t Vector_CountIf(const Vector_t *const vector, Vector_Predicate_t predicate, void *context)
+{
+    if(vector == NULL || predicate == NULL)
+    {
+        return 0;
+    }
+
+    size_t counts[PARALLEL_MAX_CHUNKS];
+    ParallelJob_t job = {
+        .source = vector->items,
+        .predicate = predicate,
+        .context = context,
+        .counts = counts,
+    };
+    parallel_plan(&job, vector->items, 0, Vector_Length(vector));
+    parallel_run(parallel_count_task, &job, job.count);
+    size_t count = 0;
+    for(size_t i = 0; i < job.count; i++)
+    {
+        count += counts[i];
+    }
+    return count;
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Starts the workers, one thread per online CPU except the calling one (see \ref
+ * VECTOR_POOL_THREADS). The pool works with fewer workers when some cannot be started.
+ */
+static void parallel_pool_start(void)
+{
+    long threads = VECTOR_POOL_THREADS > 0 ? VECTOR_POOL_THREADS : sysconf(_SC_NPROCESSORS_ONLN);
+    if(threads > PARALLEL_MAX_THREADS)
+    {
+        threads = PARALLEL_MAX_THREADS;
+    }
+    for(long i = 1; i < threads; i++)
+    {
+        pthread_t worker;
+        if(pthread_create(&worker, NULL, parallel_worker, NULL) != 0)
+        {
+            break;
+        }
+        pthread_detach(worker);
+        pthread_mutex_lock(&parallel_pool.lock);
+        parallel_pool.workers++;
+        pthread_mutex_unlock(&parallel_pool.lock);
+    }
+}
+
+/*! Waits for jobs and takes part in each of them, the worker lives as long as the process. The
+ * worker may start running only after the first job was submitted, which it must not miss, so it
+ * starts from the generation the pool is started in.
+ */
+static void *parallel_worker(void *unused)
+{
+    (void)unused;
+    ParallelPool_t *pool = &parallel_pool;
+    size_t seen = 0;
+    parallel_in_pool = true;
+    pthread_mutex_lock(&pool->lock);
+    for(;;)
+    {
+        while(pool->generation == seen)
+        {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        parallel_work(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if(--pool->active == 0)
+        {
+            pthread_cond_signal(&pool->finished);
+        }
+    }
+    return NULL;
+}
+
+/*! Takes chunks of the current job until there is none left. */
+static void parallel_work(ParallelPool_t *pool)
+{
+    for(size_t index = atomic_fetch_add(&pool->next, 1); index < pool->count;
+        index = atomic_fetch_add(&pool->next, 1))
+    {
+        pool->task(pool->context, index);
+    }
+}
+
+/*! Runs the \a task for all \a count chunks on the pool and returns when all of them are done. A
+ * single chunk, or a job submitted from a task of another job, is run directly by the calling
+ * thread.
+ */
+static void parallel_run(ParallelTask_t task, void *context, size_t count)
+{
+    ParallelPool_t *pool = &parallel_pool;
+    pthread_once(&parallel_once, parallel_pool_start);
+    if(count <= 1 || pool->workers == 0 || parallel_in_pool)
+    {
+        for(size_t i = 0; i < count; i++)
+        {
+            task(context, i);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->submit);
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->context = context;
+    pool->count = count;
+    atomic_store(&pool->next, 0);
+    pool->active = pool->workers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    parallel_in_pool = true;
+    parallel_work(pool);
+    parallel_in_pool = false;
+
+    pthread_mutex_lock(&pool->lock);
+    while(pool->active > 0)
+    {
+        pthread_cond_wait(&pool->finished, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->submit);
+}
+
+/*! Splits the items [\a start, \a end) into chunks of the \a job. All chunk boundaries except the
+ * first and the last one fall on cache line boundaries of the \a aligned array, so threads writing
+ * neighbouring chunks never share a line. Ranges shorter than \ref VECTOR_PARALLEL_MIN, or all
+ * ranges when the pool has no workers, form a single chunk.
+ */
+static void parallel_plan(ParallelJob_t *job,
+                          const Vector_DataType_t *aligned,
+                          size_t start,
+                          size_t end)
+{
+    pthread_once(&parallel_once, parallel_pool_start);
+    size_t itemCount = end - start;
+    size_t chunkCount = (parallel_pool.workers + 1) * PARALLEL_CHUNKS_PER_THREAD;
+    size_t chunk = (itemCount + chunkCount - 1) / chunkCount;
+    if(chunk < VECTOR_PARALLEL_MIN / PARALLEL_CHUNKS_PER_THREAD)
+    {
+        chunk = VECTOR_PARALLEL_MIN / PARALLEL_CHUNKS_PER_THREAD;
+    }
+    chunk = (chunk + PARALLEL_LINE_ITEMS - 1) / PARALLEL_LINE_ITEMS * PARALLEL_LINE_ITEMS;
+
+    job->start = start;
+    job->end = end;
+    job->chunk = chunk;
+    if(itemCount < VECTOR_PARALLEL_MIN || parallel_pool.workers == 0)
+    {
+        job->first_end = end;
+        job->count = itemCount > 0;
+        return;
+    }
+
+    size_t misalignment = (uintptr_t)(aligned + start) % PARALLEL_CACHE_LINE;
+    size_t head = misalignment ? (PARALLEL_CACHE_LINE - misalignment) / sizeof(Vector_DataType_t) : 0;
+    job->first_end = start + head + chunk < end ? start + head + chunk : end;
+    job->count = 1 + (end - job->first_end + chunk - 1) / chunk;
+}
+
+static void parallel_chunk(const ParallelJob_t *job, size_t index, size_t *from, size_t *to)
+{
+    *from = index == 0 ? job->start : job->first_end + (index - 1) * job->chunk;
+    *to = index == 0 ? job->first_end : *from + job->chunk;
+    if(*to > job->end)
+    {
+        *to = job->end;
+    }
+}
+
+static void parallel_fill_task(void *context, size_t index)
+{
+    const ParallelJob_t *job = context;
+    size_t from, to;
+    parallel_chunk(job, index, &from, &to);
+    for(size_t i = from; i < to; i++)
+    {
+        job->target[i] = job->value;
+    }
+}
+
+static void parallel_copy_task(void *context, size_t index)
+{
+    const ParallelJob_t *job = context;
+    size_t from, to;
+    parallel_chunk(job, index, &from, &to);
+    memcpy(job->target + from, job->source + from, (to - from) * sizeof(Vector_DataType_t));
+}
+
+static void parallel_reduce_task(void *context, size_t index)
+{
+    const ParallelJob_t *job = context;
+    size_t from, to;
+    parallel_chunk(job, index, &from, &to);
+    const Vector_DataType_t *items = job->source;
+    Vector_DataType_t value = items[from];
+    switch(job->op)
+    {
+        case VECTOR_REDUCE_SUM:
+            for(size_t i = from + 1; i < to; i++)
+            {
+                value += items[i];
+            }
+            break;
+        case VECTOR_REDUCE_MIN:
+            for(size_t i = from + 1; i < to; i++)
+            {
+                value = items[i] < value ? items[i] : value;
+            }
+            break;
+        case VECTOR_REDUCE_MAX:
+            for(size_t i = from + 1; i < to; i++)
+            {
+                value = items[i] > value ? items[i] : value;
+            }
+            break;
+    }
+    job->partials[index] = value;
+}
+
+static void parallel_count_task(void *context, size_t index)
+{
+    const ParallelJob_t *job = context;
+    size_t from, to, count = 0;
+    parallel_chunk(job, index, &from, &to);
+    for(size_t i = from; i < to; i++)
+    {
+        count += job->predicate(job->source[i], job->context);
+    }
+    job->counts[index] = count;
+}
+
+static Vector_DataType_t parallel_combine(Vector_ReduceOp_t op,
+                                          Vector_DataType_t a,
+                                          Vector_DataType_t b)
+{
+    switch(op)
+    {
+        case VECTOR_REDUCE_MIN:
+            return a < b ? a : b;
+        case VECTOR_REDUCE_MAX:
+            return a > b ? a : b;
+        default:
+            return a + b;
+    }
+}
@@ -0,0 +1,270 @@
+/*!
+ * \file       vector_setops.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Set operations over sorted vectors
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include "vector_internal.h"
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Set operation computed by \ref set_operation. */
+typedef enum {
+  SET_UNION,
+  SET_INTERSECTION,
+  SET_DIFFERENCE,
+  SET_SYMMETRIC_DIFFERENCE,
+} SetOperation_t;
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Inputs whose lengths differ at least this many times are walked by galloping search over the
+ * longer one instead of the linear merge.
+ */
+#define GALLOP_RATIO 16
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static bool set_operation(Vector_t *const result,
+                          const Vector_t *const a,
+                          const Vector_t *const b,
+                          SetOperation_t operation);
+static Vector_DataType_t *set_linear(SetOperation_t operation,
+                                     const Vector_DataType_t *a,
+                                     size_t aCount,
+                                     const Vector_DataType_t *b,
+                                     size_t bCount,
+                                     Vector_DataType_t *out);
+static Vector_DataType_t *set_gallop(SetOperation_t operation,
+                                     const Vector_DataType_t *small,
+                                     size_t smallCount,
+                                     const Vector_DataType_t *large,
+                                     size_t largeCount,
+                                     bool largeIsA,
+                                     Vector_DataType_t *out);
+static size_t gallop(const Vector_DataType_t *items, size_t count, Vector_DataType_t value);
+static Vector_DataType_t *copy_run(Vector_DataType_t *out,
+                                   const Vector_DataType_t *items,
+                                   size_t count);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+bool Vector_Union(Vector_t *const result, const Vector_t *const a, const Vector_t *const b)
+{
+    return set_operation(result, a, b, SET_UNION);
+}
+
+bool Vector_Intersect(Vector_t *const result, const Vector_t *const a, const Vector_t *const b)
+{
+    return set_operation(result, a, b, SET_INTERSECTION);
+}
+
+bool Vector_Difference(Vector_t *const result, const Vector_t *const a, const Vector_t *const b)
+{
+    return set_operation(result, a, b, SET_DIFFERENCE);
+}
+
+bool Vector_SymmetricDifference(Vector_t *const result,
+                                const Vector_t *const a,
+                                const Vector_t *const b)
+{
+    return set_operation(result, a, b, SET_SYMMETRIC_DIFFERENCE);
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Validates the arguments, expands the \a result for the largest possible output and appends the
+ * output of the \a operation to it.
+ */
+static bool set_operation(Vector_t *const result,
+                          const Vector_t *const a,
+                          const Vector_t *const b,
+                          SetOperation_t operation)
+{
+    if(result == NULL || a == NULL || b == NULL || !a->sorted || !b->sorted)
+    {
+        return false;
+    }
+
+    size_t aCount = Vector_Length(a), bCount = Vector_Length(b);
+    size_t maxCount;
+    switch(operation)
+    {
+        case SET_INTERSECTION:
+            maxCount = aCount < bCount ? aCount : bCount;
+            break;
+        case SET_DIFFERENCE:
+            maxCount = aCount;
+            break;
+        default:
+            if(SIZE_MAX - aCount < bCount)
+            {
+                return false;
+            }
+            maxCount = aCount + bCount;
+            break;
+    }
+    if(!vector_ensure_capacity(result, maxCount))
+    {
+        return false;
+    }
+
+    // items are read after the expansion because result may be one of the inputs
+    size_t appendedAt = Vector_Length(result);
+    Vector_DataType_t *out;
+    if(aCount / GALLOP_RATIO >= bCount && bCount > 0)
+    {
+        out = set_gallop(operation, b->items, bCount, a->items, aCount, true, result->next);
+    }
+    else if(bCount / GALLOP_RATIO >= aCount && aCount > 0)
+    {
+        out = set_gallop(operation, a->items, aCount, b->items, bCount, false, result->next);
+    }
+    else
+    {
+        out = set_linear(operation, a->items, aCount, b->items, bCount, result->next);
+    }
+    result->next = out;
+    vector_track_sorted(result, appendedAt, Vector_Length(result) - appendedAt, false);
+    return true;
+}
+
+/*! Computes the \a operation by walking both inputs in lockstep like \ref Merge does. Equal items
+ * are paired one to one, so inputs with repeated items are handled as multisets.
+ */
+static Vector_DataType_t *set_linear(SetOperation_t operation,
+                                     const Vector_DataType_t *a,
+                                     size_t aCount,
+                                     const Vector_DataType_t *b,
+                                     size_t bCount,
+                                     Vector_DataType_t *out)
+{
+    const Vector_DataType_t *aEnd = a + aCount, *bEnd = b + bCount;
+    bool keepA = operation != SET_INTERSECTION;
+    bool keepB = operation == SET_UNION || operation == SET_SYMMETRIC_DIFFERENCE;
+    bool keepBoth = operation == SET_UNION || operation == SET_INTERSECTION;
+
+    while(a < aEnd && b < bEnd)
+    {
+        if(*a < *b)
+        {
+            if(keepA)
+            {
+                *out++ = *a;
+            }
+            a++;
+        }
+        else if(*b < *a)
+        {
+            if(keepB)
+            {
+                *out++ = *b;
+            }
+            b++;
+        }
+        else
+        {
+            if(keepBoth)
+            {
+                *out++ = *a;
+            }
+            a++;
+            b++;
+        }
+    }
+    if(keepA)
+    {
+        out = copy_run(out, a, (size_t)(aEnd - a));
+    }
+    if(keepB)
+    {
+        out = copy_run(out, b, (size_t)(bEnd - b));
+    }
+    return out;
+}
+
+/*! Computes the \a operation when one input is much shorter than the other. For each item of the \a
+ * small input, the position of the matching item in the \a large input is found by galloping
+ * search and the items of the \a large input that were skipped over are copied (or dropped) as a
+ * single block. The \a largeIsA tells which operand of the \a operation is the \a large input.
+ */
+static Vector_DataType_t *set_gallop(SetOperation_t operation,
+                                     const Vector_DataType_t *small,
+                                     size_t smallCount,
+                                     const Vector_DataType_t *large,
+                                     size_t largeCount,
+                                     bool largeIsA,
+                                     Vector_DataType_t *out)
+{
+    bool keepA = operation != SET_INTERSECTION;
+    bool keepB = operation == SET_UNION || operation == SET_SYMMETRIC_DIFFERENCE;
+    bool keepBoth = operation == SET_UNION || operation == SET_INTERSECTION;
+    bool keepSmall = largeIsA ? keepB : keepA;
+    bool keepLarge = largeIsA ? keepA : keepB;
+
+    size_t j = 0;
+    for(size_t i = 0; i < smallCount; i++)
+    {
+        Vector_DataType_t value = small[i];
+        size_t skipped = gallop(large + j, largeCount - j, value);
+        if(keepLarge)
+        {
+            out = copy_run(out, large + j, skipped);
+        }
+        j += skipped;
+
+        if(j < largeCount && large[j] == value)
+        {
+            if(keepBoth)
+            {
+                *out++ = value;
+            }
+            j++;
+        }
+        else if(keepSmall)
+        {
+            *out++ = value;
+        }
+        else if(j == largeCount)
+        {
+            break;  // the rest of the small input can be neither matched nor kept
+        }
+    }
+    if(keepLarge)
+    {
+        out = copy_run(out, large + j, largeCount - j);
+    }
+    return out;
+}
+
+/*! Returns index of the first item that is not less than \a value in a sorted array. The bound is
+ * found by exponential search from the beginning, so the cost is logarithmic in the returned
+ * distance rather than in the length of the array.
+ */
+static size_t gallop(const Vector_DataType_t *items, size_t count, Vector_DataType_t value)
+{
+    size_t bound = 1;
+    while(bound < count && items[bound - 1] < value)
+    {
+        bound *= 2;
+    }
+    size_t low = bound / 2;
+    size_t high = bound < count ? bound : count;
+    return low + vector_lower_bound(items + low, high - low, value);
+}
+
+static Vector_DataType_t *copy_run(Vector_DataType_t *out,
+                                   const Vector_DataType_t *items,
+                                   size_t count)
+{
+    if(count > 0)
+    {
+        memcpy(out, items, count * sizeof(Vector_DataType_t));
+    }
+    return out + count;
+}
@@ -0,0 +1,303 @@
+/*!
+ * \file       vector_shared.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Vectors shared by one writer and lock free readers
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include "vector_internal.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Size of a cache line, slots of different readers are kept apart. */
+#define SHARED_CACHE_LINE 64
+
+/* Private types ---------------------------------------------------------------------------------*/
+/*! Reader slot, it holds the epoch in which the snapshot was taken or 0 when it is free. */
+typedef struct {
+  atomic_size_t epoch;
+  char padding[SHARED_CACHE_LINE - sizeof(atomic_size_t)];
+} SharedSlot_t;
+
+/*! Version replaced by a newer one that may still be held by snapshots. */
+typedef struct SharedRetired {
+  struct SharedRetired *next;
+
+  /*! The replaced version. */
+  Vector_t *vector;
+
+  /*! Epoch before the replacement, only snapshots taken in it or earlier can hold the version. */
+  size_t epoch;
+} SharedRetired_t;
+
+struct Vector_Shared {
+  /*! Current version, it is replaced by a single atomic store. */
+  _Atomic(Vector_t *) current;
+
+  /*! Global epoch, it is advanced by each publication and starts at 1. */
+  atomic_size_t epoch;
+
+  /*! Slots of the readers. */
+  SharedSlot_t slots[VECTOR_SHARED_READERS];
+
+  /*! Serializes the writers, it is held from \ref Vector_SharedBeginWrite to the publication. */
+  pthread_mutex_t writer;
+
+  /*! Private copy being modified by the writer, NULL when no write is in progress. */
+  Vector_t *draft;
+
+  /*! Reclaimed version reused as the copy of the next write. */
+  Vector_t *spare;
+
+  /*! Retired versions, the newest first. */
+  SharedRetired_t *retired;
+
+  /*! Allocator of this structure and of the list of retired versions. */
+  const Vector_Allocator_t *allocator;
+};
+
+/* Private variables -----------------------------------------------------------------------------*/
+/*! Slot taken by the last snapshot of the thread, the search for a free slot starts there, so
+ * readers running in different threads do not compete for the same slots.
+ */
+static _Thread_local size_t shared_slot_hint;
+
+/* Private function declarations -----------------------------------------------------------------*/
+static size_t shared_reclaim(Vector_Shared_t *shared);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+Vector_Shared_t *Vector_SharedCreate(Vector_t *const vector)
+{
+    if(vector == NULL)
+    {
+        return NULL;
+    }
+
+    const Vector_Allocator_t *allocator = &Vector_DefaultAllocator;
+    Vector_Shared_t *shared = allocator->alloc(allocator->context, sizeof(Vector_Shared_t));
+    if(shared == NULL)
+    {
+        return NULL;
+    }
+    if(pthread_mutex_init(&shared->writer, NULL) != 0)
+    {
+        allocator->free(allocator->context, shared, sizeof(Vector_Shared_t));
+        return NULL;
+    }
+    atomic_init(&shared->current, vector);
+    atomic_init(&shared->epoch, 1);
+    for(size_t i = 0; i < VECTOR_SHARED_READERS; i++)
+    {
+        atomic_init(&shared->slots[i].epoch, 0);
+    }
+    shared->draft = NULL;
+    shared->spare = NULL;
+    shared->retired = NULL;
+    shared->allocator = allocator;
+    return shared;
+}
+
+const Vector_t *Vector_Snapshot(Vector_Shared_t *const shared, Vector_Snapshot_t *const snapshot)
+{
+    if(shared == NULL || snapshot == NULL)
+    {
+        return NULL;
+    }
+
+    // the epoch is announced before the version is loaded, see shared_reclaim
+    size_t epoch = atomic_load(&shared->epoch);
+    for(size_t i = 0; i < VECTOR_SHARED_READERS; i++)
+    {
+        size_t slot = (shared_slot_hint + i) % VECTOR_SHARED_READERS;
+        size_t expected = 0;
+        if(atomic_load_explicit(&shared->slots[slot].epoch, memory_order_relaxed) == 0
+           && atomic_compare_exchange_strong(&shared->slots[slot].epoch, &expected, epoch))
+        {
+            shared_slot_hint = slot;
+            snapshot->vector = atomic_load(&shared->current);
+            snapshot->shared = shared;
+            snapshot->slot = slot;
+            return snapshot->vector;
+        }
+    }
+    return NULL;
+}
+
+void Vector_SnapshotRelease(Vector_Snapshot_t *const snapshot)
+{
+    if(snapshot && snapshot->vector)
+    {
+        atomic_store_explicit(&snapshot->shared->slots[snapshot->slot].epoch,
+                              0,
+                              memory_order_release);
+        snapshot->vector = NULL;
+    }
+}
+
+Vector_t *Vector_SharedBeginWrite(Vector_Shared_t *const shared)
+{
+    if(shared == NULL)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&shared->writer);
+    const Vector_t *current = atomic_load_explicit(&shared->current, memory_order_relaxed);
+    Vector_t *draft = shared->spare;
+    if(draft)
+    {
+        // the reclaimed version keeps its capacity, so it is usually refilled without allocation
+        draft->next = draft->items;
+        draft->sorted = true;
+        if(Vector_AppendVector(draft, current) == SIZE_MAX)
+        {
+            draft = NULL;
+        }
+        else
+        {
+            shared->spare = NULL;
+        }
+    }
+    else
+    {
+        draft = Vector_Copy(current);
+    }
+
+    if(draft == NULL)
+    {
+        pthread_mutex_unlock(&shared->writer);
+        return NULL;
+    }
+    shared->draft = draft;
+    return draft;
+}
+
+bool Vector_SharedPublish(Vector_Shared_t *const shared)
+{
+    if(shared == NULL || shared->draft == NULL)
+    {
+        return false;
+    }
+
+    SharedRetired_t *retired = shared->allocator->alloc(shared->allocator->context,
+                                                        sizeof(SharedRetired_t));
+    if(retired == NULL)
+    {
+        return false;
+    }
+    // readers never update the index, so the version is published with a complete one or none
+    vector_index_refresh(shared->draft);
+    retired->vector = atomic_exchange(&shared->current, shared->draft);
+    retired->epoch = atomic_fetch_add(&shared->epoch, 1);
+    retired->next = shared->retired;
+    shared->retired = retired;
+    shared->draft = NULL;
+
+    shared_reclaim(shared);
+    pthread_mutex_unlock(&shared->writer);
+    return true;
+}
+
+void Vector_SharedCancelWrite(Vector_Shared_t *const shared)
+{
+    if(shared && shared->draft)
+    {
+        if(shared->spare == NULL)
+        {
+            shared->spare = shared->draft;
+        }
+        else
+        {
+            Vector_Destroy(&shared->draft);
+        }
+        shared->draft = NULL;
+        pthread_mutex_unlock(&shared->writer);
+    }
+}
+
+size_t Vector_SharedReclaim(Vector_Shared_t *const shared)
+{
+    if(shared == NULL)
+    {
+        return SIZE_MAX;
+    }
+
+    pthread_mutex_lock(&shared->writer);
+    size_t held = shared_reclaim(shared);
+    pthread_mutex_unlock(&shared->writer);
+    return held;
+}
+
+void Vector_SharedDestroy(Vector_Shared_t **const shared)
+{
+    if(shared && *shared)
+    {
+        Vector_Shared_t *s = *shared;
+        SharedRetired_t *retired = s->retired;
+        while(retired)
+        {
+            SharedRetired_t *next = retired->next;
+            Vector_Destroy(&retired->vector);
+            s->allocator->free(s->allocator->context, retired, sizeof(SharedRetired_t));
+            retired = next;
+        }
+        Vector_t *current = atomic_load_explicit(&s->current, memory_order_relaxed);
+        Vector_Destroy(&current);
+        Vector_Destroy(&s->draft);
+        Vector_Destroy(&s->spare);
+        pthread_mutex_destroy(&s->writer);
+        s->allocator->free(s->allocator->context, s, sizeof(Vector_Shared_t));
+        *shared = NULL;
+    }
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Releases the retired versions that no snapshot can hold and returns the number of the others.
+ * A version retired in the epoch e can be held only by snapshots announced in the epoch e or
+ * earlier: a reader that read a later epoch did so after the version was replaced, so it loads a
+ * newer one. A reader that announced its epoch only after the slots were scanned loads a newer one
+ * as well. All these operations are sequentially consistent.
+ */
+static size_t shared_reclaim(Vector_Shared_t *shared)
+{
+    size_t oldest = SIZE_MAX;
+    for(size_t i = 0; i < VECTOR_SHARED_READERS; i++)
+    {
+        size_t epoch = atomic_load(&shared->slots[i].epoch);
+        if(epoch != 0 && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+    }
+
+    size_t held = 0;
+    for(SharedRetired_t **link = &shared->retired; *link;)
+    {
+        SharedRetired_t *retired = *link;
+        if(retired->epoch >= oldest)
+        {
+            held++;
+            link = &retired->next;
+            continue;
+        }
+        *link = retired->next;
+        if(shared->spare == NULL)
+        {
+            shared->spare = retired->vector;
+        }
+        else
+        {
+            Vector_Destroy(&retired->vector);
+        }
+        shared->allocator->free(shared->allocator->context, retired, sizeof(SharedRetired_t));
+    }
+    return held;
+}
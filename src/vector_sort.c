@@ -0,0 +1,261 @@
+/*!
+ * \file       vector_sort.c
+ * \author     FAI
+ * \date       10/2026
+ * \brief      Radix sort and introsort of the vector items
+ * ******************************************
+ * \attention
+ * &copy; Copyright (c) 2022 FAI UTB. All rights reserved.
+ *
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+/* Includes --------------------------------------------------------------------------------------*/
+#include "vector.h"
+#include "vector_internal.h"
+
+#include <string.h>
+
+/* Private types ---------------------------------------------------------------------------------*/
+/* Private macros --------------------------------------------------------------------------------*/
+/*! Number of bits sorted by one pass of the radix sort. */
+#define RADIX_BITS 8
+
+/*! Number of buckets of one radix sort pass. */
+#define RADIX_BUCKETS (1u << RADIX_BITS)
+
+/*! Number of radix sort passes needed for the whole key. */
+#define RADIX_PASSES ((sizeof(Vector_DataType_t) * 8 + RADIX_BITS - 1) / RADIX_BITS)
+
+/*! Partitions shorter than this are finished by insertion sort. */
+#define INSERTION_SORT_MAX 16
+
+/* Private variables -----------------------------------------------------------------------------*/
+/* Private function declarations -----------------------------------------------------------------*/
+static void radix_sort(Vector_DataType_t *items, Vector_DataType_t *buffer, size_t count);
+static void intro_sort(Vector_DataType_t *items, size_t count, unsigned depth);
+static void insertion_sort(Vector_DataType_t *items, size_t count);
+static void heap_sort(Vector_DataType_t *items, size_t count);
+static void sift_down(Vector_DataType_t *items, size_t root, size_t count);
+static unsigned depth_limit(size_t count);
+
+/* Exported functions definitions ----------------------------------------------------------------*/
+bool Vector_Sort(Vector_t *const vector)
+{
+    if(vector)
+    {
+        size_t itemCount = Vector_Length(vector);
+        if(vector->sorted || itemCount < VECTOR_SORT_RADIX_MIN)
+        {
+            return Vector_SortWithScratch(vector, NULL);
+        }
+
+        Vector_Growth_t growth = {.policy = VECTOR_GROWTH_FIXED};
+        Vector_t *scratch =
+          Vector_CreateWithAllocator(itemCount, &growth, vector_derived_allocator(vector));
+        bool sorted = Vector_SortWithScratch(vector, scratch);
+        Vector_Destroy(&scratch);
+        return sorted;
+    }
+    return false;
+}
+
+bool Vector_SortWithScratch(Vector_t *const vector, Vector_t *const scratch)
+{
+    if(vector)
+    {
+        if(vector->sorted)
+        {
+            return true;
+        }
+
+        size_t itemCount = Vector_Length(vector);
+        if(itemCount >= VECTOR_SORT_RADIX_MIN && scratch && scratch != vector
+           && Vector_Reserve(scratch, itemCount))
+        {
+            radix_sort(vector->items, scratch->items, itemCount);
+            scratch->next = scratch->items;
+            scratch->sorted = true;
+        }
+        else
+        {
+            intro_sort(vector->items, itemCount, depth_limit(itemCount));
+        }
+        vector->sorted = true;
+        vector_index_rebuild(vector);
+        return true;
+    }
+    return false;
+}
+
+/* Private function definitions ------------------------------------------------------------------*/
+/*! Sorts \a count items by LSD radix sort, \a buffer must have room for \a count items. Histograms
+ * of all digits are computed by a single pass and passes over digits that are the same for all
+ * items are skipped, so e.g. small keys need only a few passes. The sorted data end up in \a items.
+ */
+static void radix_sort(Vector_DataType_t *items, Vector_DataType_t *buffer, size_t count)
+{
+    size_t histogram[RADIX_PASSES][RADIX_BUCKETS];
+    memset(histogram, 0, sizeof(histogram));
+
+    for(size_t i = 0; i < count; i++)
+    {
+        Vector_DataType_t key = items[i];
+        for(size_t pass = 0; pass < RADIX_PASSES; pass++)
+        {
+            histogram[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    Vector_DataType_t *from = items;
+    Vector_DataType_t *to = buffer;
+    for(size_t pass = 0; pass < RADIX_PASSES; pass++)
+    {
+        size_t *buckets = histogram[pass];
+        unsigned shift = (unsigned)(pass * RADIX_BITS);
+        if(buckets[(from[0] >> shift) & (RADIX_BUCKETS - 1)] == count)
+        {
+            continue;  // all items share this digit
+        }
+
+        size_t offset = 0;
+        for(size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+        {
+            size_t bucketCount = buckets[bucket];
+            buckets[bucket] = offset;
+            offset += bucketCount;
+        }
+        for(size_t i = 0; i < count; i++)
+        {
+            Vector_DataType_t key = from[i];
+            to[buckets[(key >> shift) & (RADIX_BUCKETS - 1)]++] = key;
+        }
+
+        Vector_DataType_t *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if(from != items)
+    {
+        memcpy(items, from, count * sizeof(Vector_DataType_t));
+    }
+}
+
+/*! Sorts \a count items in place by quicksort with median of three pivot. When the recursion gets
+ * deeper than \a depth, the partition is sorted by heap sort, which bounds the worst case to
+ * O(n log n).
+ */
+static void intro_sort(Vector_DataType_t *items, size_t count, unsigned depth)
+{
+    while(count > INSERTION_SORT_MAX)
+    {
+        if(depth == 0)
+        {
+            heap_sort(items, count);
+            return;
+        }
+        depth--;
+
+        Vector_DataType_t a = items[0], b = items[count / 2], c = items[count - 1];
+        Vector_DataType_t pivot = a < b ? (b < c ? b : (a < c ? c : a))
+                                        : (a < c ? a : (b < c ? c : b));
+
+        size_t left = 0, right = count - 1;
+        for(;;)
+        {
+            while(items[left] < pivot)
+            {
+                left++;
+            }
+            while(items[right] > pivot)
+            {
+                right--;
+            }
+            if(left >= right)
+            {
+                break;
+            }
+            Vector_DataType_t swap = items[left];
+            items[left++] = items[right];
+            items[right--] = swap;
+        }
+
+        // recurse into the smaller part, iterate over the bigger one
+        size_t split = right + 1;
+        if(split < count - split)
+        {
+            intro_sort(items, split, depth);
+            items += split;
+            count -= split;
+        }
+        else
+        {
+            intro_sort(items + split, count - split, depth);
+            count = split;
+        }
+    }
+    insertion_sort(items, count);
+}
+
+static void insertion_sort(Vector_DataType_t *items, size_t count)
+{
+    for(size_t i = 1; i < count; i++)
+    {
+        Vector_DataType_t key = items[i];
+        size_t j = i;
+        while(j > 0 && items[j - 1] > key)
+        {
+            items[j] = items[j - 1];
+            j--;
+        }
+        items[j] = key;
+    }
+}
+
+static void heap_sort(Vector_DataType_t *items, size_t count)
+{
+    for(size_t root = count / 2; root > 0; root--)
+    {
+        sift_down(items, root - 1, count);
+    }
+    for(size_t end = count - 1; end > 0; end--)
+    {
+        Vector_DataType_t swap = items[0];
+        items[0] = items[end];
+        items[end] = swap;
+        sift_down(items, 0, end);
+    }
+}
+
+static void sift_down(Vector_DataType_t *items, size_t root, size_t count)
+{
+    Vector_DataType_t key = items[root];
+    size_t child;
+    while((child = 2 * root + 1) < count)
+    {
+        if(child + 1 < count && items[child + 1] > items[child])
+        {
+            child++;
+        }
+        if(items[child] <= key)
+        {
+            break;
+        }
+        items[root] = items[child];
+        root = child;
+    }
+    items[root] = key;
+}
+
+/*! Returns the recursion depth of the introsort after which it switches to heap sort. */
+static unsigned depth_limit(size_t count)
+{
+    unsigned depth = 0;
+    while(count > 1)
+    {
+        count >>= 1;
+        depth += 2;
+    }
+    return depth;
+}
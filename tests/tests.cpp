@@ -16,11 +16,24 @@
 #include "gmock/gmock.h"
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
 #include <limits>
+#include <random>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 extern "C" {
+#include "columnar_vector.h"
+#include "compressed_vector.h"
+#include "concurrent_vector.h"
+#include "segmented_vector.h"
+#include "typed_vector.h"
 #include "vector.h"
+#include "vector_kernels.h"
 }
 
 /* Private types ---------------------------------------------------------------------------------*/
@@ -346,4 +359,1643 @@ TEST(vector, vectorSetNullContainer)
   Vector_Set(nullptr, 0, 0);
 }
 
+TEST(vector, createWithGeometricGrowth)
+{
+  Vector_Growth_t growth = {VECTOR_GROWTH_GEOMETRIC, 0, 2.0, 0};
+  Vector_t *v = Vector_CreateWithGrowth(4, &growth);
+
+  ASSERT_NE(v, nullptr);
+  for (Vector_DataType_t i = 0; i < 5; ++i) {
+    Vector_Append(v, i);
+  }
+  ASSERT_EQ(v->size, 8);
+
+  for (Vector_DataType_t i = 5; i < 9; ++i) {
+    Vector_Append(v, i);
+  }
+  ASSERT_EQ(v->size, 16);
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+  Vector_Destroy(&v);
+}
+
+TEST(vector, createWithHybridGrowth)
+{
+  Vector_Growth_t growth = {VECTOR_GROWTH_HYBRID, 10, 2.0, 20};
+  Vector_t *v = Vector_CreateWithGrowth(10, &growth);
+
+  ASSERT_NE(v, nullptr);
+  for (Vector_DataType_t i = 0; i < 11; ++i) {
+    Vector_Append(v, i);
+  }
+  ASSERT_EQ(v->size, 20);
+
+  for (Vector_DataType_t i = 11; i < 21; ++i) {
+    Vector_Append(v, i);
+  }
+  ASSERT_EQ(v->size, 40);
+
+  Vector_Destroy(&v);
+}
+
+TEST(vector, createWithInvalidGrowthFactor)
+{
+  Vector_Growth_t growth = {VECTOR_GROWTH_GEOMETRIC, 0, 1.0, 0};
+
+  ASSERT_EQ(Vector_CreateWithGrowth(10, &growth), nullptr);
+  ASSERT_EQ(Vector_CreateWithGrowth(10, nullptr), nullptr);
+}
+
+TEST(vector, appendWithZeroAllocStep)
+{
+  Vector_t *v = Vector_Create(1, 0);
+
+  Vector_Append(v, 1);
+  ASSERT_EQ(Vector_Append(v, 2), 1);
+  ASSERT_EQ(v->size, std::max<size_t>(2, VECTOR_INLINE_CAPACITY));
+
+  Vector_Destroy(&v);
+}
+
+TEST_F(VectorFullTest, appendArrayExpandsOnce)
+{
+  Vector_DataType_t values[200];
+  for (Vector_DataType_t i = 0; i < 200; ++i) {
+    values[i] = i;
+  }
+
+  ASSERT_EQ(Vector_AppendArray(v, values, 200), 3);
+  ASSERT_EQ(Vector_Length(v), 203);
+  ASSERT_EQ(v->size, 203);
+  ASSERT_EQ(v->items[2], 123);
+  ASSERT_EQ(v->items[202], 199);
+}
+
+TEST_F(VectorFullTest, appendVectorToItself)
+{
+  ASSERT_EQ(Vector_AppendVector(v, v), 3);
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({123, 321, 123, 123, 321, 123}));
+}
+
+TEST_F(VectorFullTest, insertRangeInTheMiddle)
+{
+  Vector_DataType_t values[] = {1, 2};
+
+  ASSERT_TRUE(Vector_InsertRange(v, 1, values, 2));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({123, 1, 2, 321, 123}));
+  ASSERT_FALSE(Vector_InsertRange(v, 6, values, 2));
+  ASSERT_FALSE(Vector_InsertRange(nullptr, 0, values, 2));
+}
+
+TEST(vector, mergeSortedVectors)
+{
+  Vector_t *v1 = Vector_Create(2, 2);
+  Vector_t *v2 = Vector_Create(2, 2);
+  Vector_t *result = Vector_Create(1, 1);
+  Vector_DataType_t a[] = {1, 4, 4, 9};
+  Vector_DataType_t b[] = {2, 4, 10, 11, 12};
+
+  Vector_AppendArray(v1, a, 4);
+  Vector_AppendArray(v2, b, 5);
+  Merge(result, v1, v2);
+  ASSERT_THAT(std::vector<Vector_DataType_t>(result->items, result->items + Vector_Length(result)),
+              ::testing::ElementsAreArray({1, 2, 4, 4, 4, 9, 10, 11, 12}));
+
+  Vector_Destroy(&v1);
+  Vector_Destroy(&v2);
+  Vector_Destroy(&result);
+}
+
+TEST_F(VectorFullTest, reserveOnlyGrows)
+{
+  ASSERT_TRUE(Vector_Reserve(v, 50));
+  ASSERT_EQ(Vector_Capacity(v), 50);
+  ASSERT_TRUE(Vector_Reserve(v, 5));
+  ASSERT_EQ(Vector_Capacity(v), 50);
+  ASSERT_EQ(Vector_Length(v), 3);
+  ASSERT_FALSE(Vector_Reserve(v, SIZE_MAX));
+  ASSERT_EQ(Vector_Capacity(v), 50);
+  ASSERT_EQ(v->items[1], 321);
+}
+
+TEST_F(VectorFullTest, shrinkToFitReleasesUnusedCells)
+{
+  ASSERT_TRUE(Vector_ShrinkToFit(v));
+  ASSERT_EQ(Vector_Capacity(v), std::max<size_t>(3, VECTOR_INLINE_CAPACITY));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({123, 321, 123}));
+
+  Vector_Resize(v, 0, 0);
+  ASSERT_TRUE(Vector_ShrinkToFit(v));
+  ASSERT_EQ(Vector_Capacity(v), 0);
+  ASSERT_EQ(v->items, nullptr);
+  ASSERT_EQ(Vector_Append(v, 7), 0);
+}
+
+TEST_F(VectorFullTest, resizeGrowsWithValueAndTruncates)
+{
+  ASSERT_TRUE(Vector_Resize(v, 5, 9));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({123, 321, 123, 9, 9}));
+
+  ASSERT_TRUE(Vector_Resize(v, 1, 0));
+  ASSERT_EQ(Vector_Length(v), 1);
+  ASSERT_EQ(Vector_Capacity(v), 10);
+  ASSERT_FALSE(Vector_Resize(nullptr, 1, 0));
+}
+
+TEST_F(VectorTest, searchFindsEveryPositionForAllLengths)
+{
+  for (Vector_DataType_t length = 0; length < 40; ++length) {
+    Vector_Resize(v, 0, 0);
+    // descending order keeps the vector unsorted, so the SIMD kernels are used
+    for (Vector_DataType_t i = 0; i < length; ++i) {
+      Vector_Append(v, length - i);
+    }
+    Vector_Append(v, 0);
+
+    for (Vector_DataType_t i = 0; i <= length; ++i) {
+      ASSERT_TRUE(Vector_Contains(v, length - i));
+      ASSERT_EQ(Vector_IndexOf(v, length - i, 0), i);
+      ASSERT_EQ(Vector_LastIndexOf(v, length - i, SIZE_MAX), i);
+      ASSERT_EQ(Vector_CountOf(v, length - i), 1);
+    }
+    ASSERT_FALSE(Vector_Contains(v, length + 1));
+    ASSERT_EQ(Vector_IndexOf(v, length + 1, 0), SIZE_MAX);
+    ASSERT_EQ(Vector_LastIndexOf(v, length + 1, SIZE_MAX), SIZE_MAX);
+    ASSERT_EQ(Vector_CountOf(v, length + 1), 0);
+  }
+}
+
+TEST_F(VectorFullTest, lastIndexOfSearchesBackwardsFromPosition)
+{
+  ASSERT_EQ(Vector_LastIndexOf(v, 123, 2), 2);
+  ASSERT_EQ(Vector_LastIndexOf(v, 123, 1), 0);
+  ASSERT_EQ(Vector_LastIndexOf(v, 321, 0), SIZE_MAX);
+  ASSERT_EQ(Vector_LastIndexOf(nullptr, 123, 0), SIZE_MAX);
+}
+
+TEST_F(VectorTest, countOfRepeatedValue)
+{
+  for (int i = 0; i < 37; i++) {
+    Vector_Append(v, i % 3);
+  }
+
+  ASSERT_EQ(Vector_CountOf(v, 0), 13);
+  ASSERT_EQ(Vector_CountOf(v, 2), 12);
+  ASSERT_EQ(Vector_CountOf(nullptr, 0), 0);
+}
+
+TEST_F(VectorTest, removeRangeShiftsTail)
+{
+  for (Vector_DataType_t i = 0; i < 10; ++i) {
+    Vector_Append(v, i);
+  }
+
+  ASSERT_TRUE(Vector_RemoveRange(v, 2, 4));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({0, 1, 5, 6, 7, 8, 9}));
+  ASSERT_TRUE(Vector_RemoveRange(v, 5, 100));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({0, 1, 5, 6, 7}));
+  ASSERT_FALSE(Vector_RemoveRange(v, 5, 6));
+  ASSERT_FALSE(Vector_RemoveRange(v, 3, 2));
+  ASSERT_FALSE(Vector_RemoveRange(nullptr, 0, 0));
+}
+
+static bool isOdd(Vector_DataType_t value, void *context)
+{
+  ++*static_cast<int *>(context);
+  return value % 2 == 1;
+}
+
+TEST_F(VectorTest, removeIfKeepsOrder)
+{
+  Vector_DataType_t values[] = {1, 2, 3, 3, 4, 6, 7, 8, 9};
+  int calls = 0;
+
+  Vector_AppendArray(v, values, 9);
+  ASSERT_EQ(Vector_RemoveIf(v, isOdd, &calls), 5);
+  ASSERT_EQ(calls, 9);
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({2, 4, 6, 8}));
+  ASSERT_EQ(Vector_RemoveIf(v, nullptr, nullptr), 0);
+}
+
+TEST_F(VectorTest, removeIndicesCompactsOnce)
+{
+  for (Vector_DataType_t i = 0; i < 10; ++i) {
+    Vector_Append(v, i);
+  }
+  size_t unsorted[] = {3, 1};
+  size_t positions[] = {0, 3, 3, 4, 9, 42};
+
+  ASSERT_EQ(Vector_RemoveIndices(v, unsorted, 2), 0);
+  ASSERT_EQ(Vector_Length(v), 10);
+  ASSERT_EQ(Vector_RemoveIndices(v, positions, 6), 4);
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({1, 2, 5, 6, 7, 8}));
+}
+
+TEST_F(VectorFullTest, swapRemoveMovesLastItem)
+{
+  Vector_Append(v, 7);
+
+  ASSERT_TRUE(Vector_SwapRemove(v, 0));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({7, 321, 123}));
+  ASSERT_TRUE(Vector_SwapRemove(v, 2));
+  ASSERT_EQ(Vector_Length(v), 2);
+  ASSERT_FALSE(Vector_SwapRemove(v, 2));
+}
+
+TEST_F(VectorTest, sortedFlagFollowsModifications)
+{
+  ASSERT_TRUE(Vector_IsSorted(v));
+  Vector_Append(v, 1);
+  Vector_Append(v, 5);
+  Vector_Append(v, 5);
+  ASSERT_TRUE(Vector_IsSorted(v));
+
+  Vector_Set(v, 0, 6);
+  ASSERT_FALSE(Vector_IsSorted(v));
+  ASSERT_TRUE(Vector_Sort(v));
+  ASSERT_TRUE(Vector_IsSorted(v));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({5, 5, 6}));
+
+  Vector_DataType_t values[] = {7, 3};
+  Vector_AppendArray(v, values, 2);
+  ASSERT_FALSE(Vector_IsSorted(v));
+  Vector_Remove(v, 4);
+  ASSERT_FALSE(Vector_IsSorted(v));
+  Vector_Sort(v);
+  Vector_Fill(v, 9, 1, 2);
+  ASSERT_FALSE(Vector_IsSorted(v));
+}
+
+TEST_F(VectorTest, insertSortedAndBounds)
+{
+  for (Vector_DataType_t value : {5, 1, 9, 5, 3}) {
+    Vector_InsertSorted(v, value);
+  }
+
+  ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+              ::testing::ElementsAreArray({1, 3, 5, 5, 9}));
+  ASSERT_EQ(Vector_LowerBound(v, 5), 2);
+  ASSERT_EQ(Vector_UpperBound(v, 5), 4);
+  ASSERT_EQ(Vector_LowerBound(v, 10), 5);
+  ASSERT_EQ(Vector_UpperBound(v, 0), 0);
+
+  size_t first, last;
+  ASSERT_TRUE(Vector_EqualRange(v, 4, &first, &last));
+  ASSERT_EQ(first, 2);
+  ASSERT_EQ(last, 2);
+
+  ASSERT_EQ(Vector_IndexOf(v, 5, 0), 2);
+  ASSERT_EQ(Vector_IndexOf(v, 5, 3), 3);
+  ASSERT_EQ(Vector_IndexOf(v, 5, 4), SIZE_MAX);
+  ASSERT_EQ(Vector_LastIndexOf(v, 5, SIZE_MAX), 3);
+  ASSERT_EQ(Vector_CountOf(v, 5), 2);
+  ASSERT_FALSE(Vector_Contains(v, 4));
+
+  Vector_Set(v, 0, 100);
+  ASSERT_EQ(Vector_InsertSorted(v, 1), SIZE_MAX);
+  ASSERT_EQ(Vector_LowerBound(v, 1), SIZE_MAX);
+  ASSERT_FALSE(Vector_EqualRange(v, 1, &first, &last));
+}
+
+TEST_F(VectorTest, sortMatchesStdSort)
+{
+  std::mt19937_64 random(42);
+  for (size_t length : {0, 1, 15, 17, 255, 256, 5000}) {
+    std::vector<Vector_DataType_t> expected(length);
+    for (auto &value : expected) {
+      value = length % 2 ? random() : random() % 1000;
+    }
+
+    Vector_Resize(v, 0, 0);
+    Vector_AppendArray(v, expected.data(), length);
+    std::sort(expected.begin(), expected.end());
+
+    ASSERT_TRUE(Vector_Sort(v));
+    ASSERT_TRUE(Vector_IsSorted(v));
+    ASSERT_THAT(std::vector<Vector_DataType_t>(v->items, v->items + Vector_Length(v)),
+                ::testing::ElementsAreArray(expected));
+  }
+}
+
+TEST_F(VectorTest, sortWithReusedScratch)
+{
+  Vector_t *scratch = Vector_Create(1, 1);
+  for (int round = 0; round < 3; round++) {
+    Vector_Resize(v, 0, 0);
+    for (Vector_DataType_t i = 1000; i > 0; --i) {
+      Vector_Append(v, i * 7 % 1001);
+    }
+
+    ASSERT_TRUE(Vector_SortWithScratch(v, scratch));
+    ASSERT_TRUE(std::is_sorted(v->items, v->items + Vector_Length(v)));
+    ASSERT_EQ(Vector_Length(scratch), 0);
+    ASSERT_GE(Vector_Capacity(scratch), 1000);
+  }
+
+  ASSERT_FALSE(Vector_SortWithScratch(nullptr, scratch));
+  Vector_Destroy(&scratch);
+}
+
+TEST_F(VectorTest, introsortHandlesDuplicates)
+{
+  for (int i = 0; i < 200; i++) {
+    Vector_Append(v, i % 2 ? 5 : 3);
+  }
+
+  ASSERT_TRUE(Vector_Sort(v));
+  ASSERT_EQ(Vector_UpperBound(v, 3), 100);
+  ASSERT_EQ(Vector_CountOf(v, 5), 100);
+}
+
+TEST(vector, mergeManySortedVectors)
+{
+  std::mt19937_64 random(7);
+  std::vector<Vector_DataType_t> expected;
+  Vector_t *inputs[5];
+  for (size_t i = 0; i < 5; i++) {
+    inputs[i] = Vector_Create(1, 16);
+    for (size_t j = 0; j < i * 37; j++) {
+      Vector_DataType_t value = random() % 100;
+      Vector_Append(inputs[i], value);
+      expected.push_back(value);
+    }
+    Vector_Sort(inputs[i]);
+  }
+  std::sort(expected.begin(), expected.end());
+  Vector_t *result = Vector_Create(1, 1);
+
+  ASSERT_TRUE(Vector_MergeK(result, inputs, 5, false));
+  ASSERT_TRUE(Vector_IsSorted(result));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(result->items, result->items + Vector_Length(result)),
+              ::testing::ElementsAreArray(expected));
+
+  Vector_Resize(result, 0, 0);
+  expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+  ASSERT_TRUE(Vector_MergeK(result, inputs, 5, true));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(result->items, result->items + Vector_Length(result)),
+              ::testing::ElementsAreArray(expected));
+
+  for (auto &input : inputs) {
+    Vector_Destroy(&input);
+  }
+  Vector_Destroy(&result);
+}
+
+TEST_F(VectorFullTest, mergeKRejectsUnsortedInput)
+{
+  Vector_t *result = Vector_Create(1, 1);
+
+  ASSERT_FALSE(Vector_MergeK(result, &v, 1, false));
+  ASSERT_EQ(Vector_Length(result), 0);
+  ASSERT_TRUE(Vector_MergeK(result, nullptr, 0, false));
+  ASSERT_FALSE(Vector_MergeK(nullptr, &v, 1, false));
+  // the inputs are not read when the merge tree would not fit in memory
+  ASSERT_FALSE(Vector_MergeK(result, &v, SIZE_MAX / (2 * sizeof(void *)) + 1, false));
+
+  Vector_Destroy(&result);
+}
+
+TEST(vector, mergeParallelMatchesMerge)
+{
+  std::mt19937_64 random(11);
+  Vector_t *v1 = Vector_Create(1, 1);
+  Vector_t *v2 = Vector_Create(1, 1);
+  Vector_Resize(v1, 3 * VECTOR_MERGE_PARALLEL_MIN, 0);
+  Vector_Resize(v2, VECTOR_MERGE_PARALLEL_MIN + 17, 0);
+  for (size_t i = 0; i < Vector_Length(v1); i++) {
+    Vector_Set(v1, i, random() % 5000);
+  }
+  for (size_t i = 0; i < Vector_Length(v2); i++) {
+    Vector_Set(v2, i, random() % 5000);
+  }
+  Vector_Sort(v1);
+  Vector_Sort(v2);
+
+  Vector_t *expected = Vector_Create(1, 1);
+  Merge(expected, v1, v2);
+  for (size_t threads : {0, 1, 3, 8}) {
+    Vector_t *result = Vector_Create(1, 1);
+    Vector_Append(result, 0);
+
+    ASSERT_TRUE(Vector_MergeParallel(result, v1, v2, threads));
+    ASSERT_EQ(Vector_Length(result), Vector_Length(expected) + 1);
+    ASSERT_TRUE(std::equal(expected->items, expected->next, result->items + 1));
+    ASSERT_TRUE(Vector_IsSorted(result));
+    Vector_Destroy(&result);
+  }
+
+  Vector_Set(v2, 0, 10000);
+  ASSERT_FALSE(Vector_MergeParallel(expected, v1, v2, 2));
+
+  Vector_Destroy(&v1);
+  Vector_Destroy(&v2);
+  Vector_Destroy(&expected);
+}
+
+TEST(vector, setOperationsMatchStdAlgorithms)
+{
+  std::mt19937_64 random(3);
+  // balanced inputs use the linear walk, the others the galloping search
+  for (auto lengths :
+       {std::make_pair(300, 250), std::make_pair(2000, 20), std::make_pair(5, 900)}) {
+    std::vector<Vector_DataType_t> a(lengths.first), b(lengths.second);
+    for (auto &value : a) {
+      value = random() % 400;
+    }
+    for (auto &value : b) {
+      value = random() % 400;
+    }
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    Vector_t *va = Vector_Create(1, 1);
+    Vector_t *vb = Vector_Create(1, 1);
+    Vector_AppendArray(va, a.data(), a.size());
+    Vector_AppendArray(vb, b.data(), b.size());
+
+    std::vector<Vector_DataType_t> expected;
+    Vector_t *result = Vector_Create(1, 1);
+
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    ASSERT_TRUE(Vector_Union(result, va, vb));
+    ASSERT_THAT(std::vector<Vector_DataType_t>(result->items, result->next),
+                ::testing::ElementsAreArray(expected));
+
+    expected.clear();
+    Vector_Resize(result, 0, 0);
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    ASSERT_TRUE(Vector_Intersect(result, va, vb));
+    ASSERT_THAT(std::vector<Vector_DataType_t>(result->items, result->next),
+                ::testing::ElementsAreArray(expected));
+
+    expected.clear();
+    Vector_Resize(result, 0, 0);
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    ASSERT_TRUE(Vector_Difference(result, va, vb));
+    ASSERT_THAT(std::vector<Vector_DataType_t>(result->items, result->next),
+                ::testing::ElementsAreArray(expected));
+
+    expected.clear();
+    Vector_Resize(result, 0, 0);
+    std::set_symmetric_difference(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    ASSERT_TRUE(Vector_SymmetricDifference(result, va, vb));
+    ASSERT_THAT(std::vector<Vector_DataType_t>(result->items, result->next),
+                ::testing::ElementsAreArray(expected));
+    ASSERT_TRUE(Vector_IsSorted(result));
+
+    Vector_Destroy(&va);
+    Vector_Destroy(&vb);
+    Vector_Destroy(&result);
+  }
+}
+
+TEST_F(VectorFullTest, setOperationsRejectUnsortedInput)
+{
+  Vector_t *result = Vector_Create(1, 1);
+
+  ASSERT_FALSE(Vector_Union(result, v, result));
+  ASSERT_FALSE(Vector_Intersect(result, result, v));
+  ASSERT_FALSE(Vector_Difference(nullptr, result, result));
+  ASSERT_EQ(Vector_Length(result), 0);
+
+  Vector_Destroy(&result);
+}
+
+TEST(vector, countingAllocatorTracksVectorMemory)
+{
+  Vector_CountingAllocator_t counting;
+  Vector_CountingAllocatorInit(&counting, nullptr);
+  Vector_Growth_t growth = {VECTOR_GROWTH_FIXED, 10, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+
+  Vector_t *v = Vector_CreateWithAllocator(10, &growth, &counting.allocator);
+  ASSERT_NE(v, nullptr);
+  ASSERT_EQ(counting.stats.allocations, 2);
+  ASSERT_EQ(counting.stats.live_bytes, sizeof(Vector_t) + 10 * sizeof(Vector_DataType_t));
+
+  for (Vector_DataType_t i = 0; i < 35; i++) {
+    Vector_Append(v, i);
+  }
+  ASSERT_EQ(counting.stats.reallocations, 3);
+  ASSERT_EQ(counting.stats.live_bytes, sizeof(Vector_t) + 40 * sizeof(Vector_DataType_t));
+  ASSERT_LE(counting.stats.bytes_moved, (10 + 20 + 30) * sizeof(Vector_DataType_t));
+
+  Vector_t *copy = Vector_Copy(v);
+  ASSERT_EQ(copy->allocator, &counting.allocator);
+  ASSERT_EQ(counting.stats.allocations, 4);
+  size_t peak = counting.stats.live_bytes;
+
+  Vector_Destroy(&copy);
+  Vector_Destroy(&v);
+  ASSERT_EQ(counting.stats.frees, 4);
+  ASSERT_EQ(counting.stats.live_bytes, 0);
+  ASSERT_EQ(counting.stats.peak_bytes, peak);
+
+  Vector_CountingAllocatorReset(&counting);
+  ASSERT_EQ(counting.stats.allocations, 0);
+  ASSERT_EQ(counting.stats.peak_bytes, 0);
+}
+
+TEST(vector, createWithAllocatorRejectsFailedAllocation)
+{
+  Vector_Allocator_t failing = {
+    [](void *, size_t) -> void * { return nullptr; },
+    [](void *, void *, size_t, size_t) -> void * { return nullptr; },
+    [](void *, void *, size_t) {},
+    nullptr,
+  };
+  Vector_Growth_t growth = {VECTOR_GROWTH_FIXED, 10, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+
+  ASSERT_EQ(Vector_CreateWithAllocator(10, &growth, &failing), nullptr);
+  ASSERT_EQ(Vector_CreateWithAllocator(10, &growth, nullptr), nullptr);
+}
+
+TEST(vector, arenaVectorsGrowInPlaceAndAreReleasedAtOnce)
+{
+  Vector_Arena_t *arena = Vector_ArenaCreate(4096);
+  ASSERT_NE(arena, nullptr);
+
+  Vector_t *v = Vector_CreateInArena(arena, VECTOR_INLINE_CAPACITY + 4, 4);
+  ASSERT_NE(v, nullptr);
+  ASSERT_EQ(v->allocator, Vector_ArenaAllocator(arena));
+  Vector_DataType_t *items = v->items;
+  for (Vector_DataType_t i = 0; i < 100; i++) {
+    Vector_Append(v, i);
+  }
+  ASSERT_EQ(v->items, items);  // the last block grows in place
+  ASSERT_EQ(Vector_Length(v), 100);
+  ASSERT_EQ(v->items[99], 99);
+
+  // a big block gets a chunk of its own
+  Vector_t *big = Vector_CreateInArena(arena, 10000, 1);
+  ASSERT_NE(big, nullptr);
+  Vector_Fill(big, 1, 0, 10000);
+  ASSERT_EQ(v->items[99], 99);
+
+  // released headers are reused
+  Vector_t *header = big;
+  Vector_Destroy(&big);
+  Vector_t *small = Vector_CreateInArena(arena, 1, 1);
+  ASSERT_EQ(small, header);
+
+  Vector_t *copy = Vector_Copy(v);
+  ASSERT_THAT(std::vector<Vector_DataType_t>(copy->items, copy->next),
+              ::testing::ElementsAreArray(v->items, 100));
+
+  // all vectors are released by the reset, regular chunks are reused
+  Vector_ArenaReset(arena);
+  Vector_t *again = Vector_CreateInArena(arena, VECTOR_INLINE_CAPACITY + 4, 4);
+  ASSERT_EQ(again, v);
+
+  Vector_ArenaDestroy(&arena);
+  ASSERT_EQ(arena, nullptr);
+  ASSERT_EQ(Vector_CreateInArena(arena, 1, 1), nullptr);
+
+  // a vector growing far past the chunk size resizes its own chunk, so the memory stays linear
+  Vector_CountingAllocator_t counting;
+  Vector_CountingAllocatorInit(&counting, nullptr);
+  ASSERT_EQ(Vector_ArenaCreateWithAllocator(4096, nullptr), nullptr);
+  arena = Vector_ArenaCreateWithAllocator(4096, &counting.allocator);
+  ASSERT_NE(arena, nullptr);
+  Vector_t *grown = Vector_CreateInArena(arena, 10, 100);
+  const size_t count = 100000;
+  for (Vector_DataType_t i = 0; i < count; i++) {
+    ASSERT_EQ(Vector_Append(grown, i), i);
+  }
+  ASSERT_EQ(grown->items[count - 1], count - 1);
+  ASSERT_LE(counting.stats.peak_bytes, 2 * count * sizeof(Vector_DataType_t) + 4 * 4096);
+
+  // the regular chunk is still the current one, small blocks are cut from it
+  size_t allocations = counting.stats.allocations;
+  Vector_t *small2 = Vector_CreateInArena(arena, 1, 1);
+  ASSERT_NE(small2, nullptr);
+  ASSERT_EQ(counting.stats.allocations, allocations);
+
+  // the dedicated chunk is returned to the backend when the vector is destroyed
+  Vector_Destroy(&grown);
+  ASSERT_LE(counting.stats.live_bytes, 4 * 4096);
+  Vector_ArenaDestroy(&arena);
+  ASSERT_EQ(counting.stats.live_bytes, 0);
+}
+
+TEST(vector, tinyVectorSpillsToHeapAndBack)
+{
+  Vector_t *v = Vector_Create(1, 1);
+#if VECTOR_INLINE_CAPACITY > 0
+  ASSERT_EQ(v->items, v->inline_items);
+  ASSERT_EQ(Vector_Capacity(v), VECTOR_INLINE_CAPACITY);
+#endif
+
+  for (Vector_DataType_t i = 0; i < VECTOR_INLINE_CAPACITY + 10; i++) {
+    ASSERT_EQ(Vector_Append(v, i), i);
+  }
+  ASSERT_EQ(Vector_Length(v), VECTOR_INLINE_CAPACITY + 10);
+  ASSERT_EQ(v->items[VECTOR_INLINE_CAPACITY + 9], VECTOR_INLINE_CAPACITY + 9);
+
+  Vector_Resize(v, 1, 0);
+  ASSERT_TRUE(Vector_ShrinkToFit(v));
+  ASSERT_EQ(Vector_Length(v), 1);
+  ASSERT_EQ(v->items[0], 0);
+#if VECTOR_INLINE_CAPACITY > 0
+  ASSERT_EQ(v->items, v->inline_items);
+#endif
+
+  Vector_t *c = Vector_Copy(v);
+  ASSERT_NE(c->items, v->items);
+  ASSERT_EQ(c->items[0], 0);
+
+  Vector_Destroy(&c);
+  Vector_Destroy(&v);
+}
+
+TEST(segmentedVector, matchesStdVectorAcrossChunks)
+{
+  const size_t length = 3 * SEGMENTED_VECTOR_CHUNK_SIZE + 5;
+  SegmentedVector_t *v = SegmentedVector_Create(10);
+  ASSERT_NE(v, nullptr);
+  std::vector<Vector_DataType_t> expected;
+
+  for (size_t i = 0; i < length; i++) {
+    ASSERT_EQ(SegmentedVector_Append(v, i), i);
+    expected.push_back(i);
+  }
+  Vector_DataType_t *first = SegmentedVector_ItemAddress(v, 0);
+  Vector_DataType_t *boundary = SegmentedVector_ItemAddress(v, SEGMENTED_VECTOR_CHUNK_SIZE);
+  for (size_t i = 0; i < 100; i++) {
+    SegmentedVector_Append(v, 0);
+    expected.push_back(0);
+  }
+  ASSERT_EQ(SegmentedVector_ItemAddress(v, 0), first);  // appending never moves items
+  ASSERT_EQ(SegmentedVector_ItemAddress(v, SEGMENTED_VECTOR_CHUNK_SIZE), boundary);
+
+  SegmentedVector_Set(v, SEGMENTED_VECTOR_CHUNK_SIZE - 1, 777);
+  expected[SEGMENTED_VECTOR_CHUNK_SIZE - 1] = 777;
+  SegmentedVector_Fill(v, 5, SEGMENTED_VECTOR_CHUNK_SIZE - 3, 2 * SEGMENTED_VECTOR_CHUNK_SIZE + 2);
+  std::fill(expected.begin() + SEGMENTED_VECTOR_CHUNK_SIZE - 3,
+            expected.begin() + 2 * SEGMENTED_VECTOR_CHUNK_SIZE + 3,
+            5);
+
+  for (size_t position : {size_t(0),
+                          SEGMENTED_VECTOR_CHUNK_SIZE - 1,
+                          SEGMENTED_VECTOR_CHUNK_SIZE,
+                          2 * SEGMENTED_VECTOR_CHUNK_SIZE + 7,
+                          expected.size() - 5}) {  // the last item after the removals
+    ASSERT_TRUE(SegmentedVector_Remove(v, position));
+    expected.erase(expected.begin() + position);
+  }
+  ASSERT_FALSE(SegmentedVector_Remove(v, expected.size()));
+
+  ASSERT_EQ(SegmentedVector_Length(v), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    Vector_DataType_t value;
+    ASSERT_TRUE(SegmentedVector_At(v, i, &value));
+    ASSERT_EQ(value, expected[i]) << "at " << i;
+  }
+  Vector_DataType_t value;
+  ASSERT_FALSE(SegmentedVector_At(v, expected.size(), &value));
+
+  for (Vector_DataType_t searched : {Vector_DataType_t(5),
+                                     Vector_DataType_t(2 * SEGMENTED_VECTOR_CHUNK_SIZE + 10),
+                                     Vector_DataType_t(length - 1),
+                                     Vector_DataType_t(length)}) {
+    auto found = std::find(expected.begin() + 1, expected.end(), searched);
+    size_t index = found == expected.end() ? SIZE_MAX : found - expected.begin();
+    ASSERT_EQ(SegmentedVector_IndexOf(v, searched, 1), index);
+  }
+  ASSERT_TRUE(SegmentedVector_Contains(v, 0));
+  ASSERT_FALSE(SegmentedVector_Contains(v, length));
+
+  while (SegmentedVector_Length(v) > 0) {
+    SegmentedVector_Remove(v, 0);
+  }
+  ASSERT_LE(v->chunk_count, 1);
+  ASSERT_EQ(SegmentedVector_Append(v, 1), 0);
+
+  SegmentedVector_Destroy(&v);
+  ASSERT_EQ(v, nullptr);
+  ASSERT_EQ(SegmentedVector_Length(v), SIZE_MAX);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(vector, mappedVectorPersistsBetweenOpens)
+{
+  std::string path = ::testing::TempDir() + "vector_mapped_test.bin";
+
+  Vector_t *v = Vector_OpenMapped(path.c_str(), VECTOR_MAP_CREATE);
+  ASSERT_NE(v, nullptr);
+  ASSERT_EQ(Vector_Length(v), 0);
+
+  // the allocator of the file cannot allocate the structures of other vectors
+  Vector_Growth_t growth = {VECTOR_GROWTH_FIXED, 10, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+  ASSERT_EQ(Vector_CreateWithAllocator(4, &growth, v->allocator), nullptr);
+  ASSERT_EQ(SegmentedVector_CreateWithAllocator(4, v->allocator), nullptr);
+  for (Vector_DataType_t i = 0; i < 10000; i++) {
+    ASSERT_EQ(Vector_Append(v, 2 * i), i);
+  }
+  ASSERT_TRUE(Vector_SyncMapped(v));
+  ASSERT_EQ(Vector_IndexOf(v, 2000, 0), 1000);
+
+  Vector_t *other = Vector_Create(1, 1);
+  Vector_Append(other, 1);
+  Vector_t *merged = Vector_Create(1, 1);
+  Merge(merged, v, other);
+  ASSERT_EQ(Vector_Length(merged), 10001);
+  ASSERT_EQ(merged->allocator, &Vector_DefaultAllocator);
+  Vector_t *copy = Vector_Copy(v);
+  ASSERT_EQ(copy->allocator, &Vector_DefaultAllocator);
+  Vector_Destroy(&copy);
+  Vector_Destroy(&merged);
+  Vector_Destroy(&other);
+  Vector_Destroy(&v);
+
+  v = Vector_OpenMapped(path.c_str(), VECTOR_MAP_READ_WRITE);
+  ASSERT_NE(v, nullptr);
+  ASSERT_EQ(Vector_Length(v), 10000);
+  ASSERT_TRUE(Vector_IsSorted(v));
+  ASSERT_EQ(v->items[9999], 19998);
+  Vector_Append(v, 1);
+  ASSERT_FALSE(Vector_IsSorted(v));
+  Vector_Destroy(&v);
+
+  // changes of a read only vector stay in memory
+  v = Vector_OpenMapped(path.c_str(), VECTOR_MAP_READ_ONLY);
+  ASSERT_NE(v, nullptr);
+  ASSERT_EQ(Vector_Length(v), 10001);
+  Vector_Set(v, 0, 42);
+  ASSERT_EQ(Vector_Append(v, 3), SIZE_MAX);
+  ASSERT_FALSE(Vector_SyncMapped(v));
+  Vector_Destroy(&v);
+
+  // a cleared vector empties its file at once, not only when it is destroyed
+  v = Vector_OpenMapped(path.c_str(), VECTOR_MAP_READ_WRITE);
+  ASSERT_EQ(v->items[0], 0);
+  Vector_Clear(v);
+  Vector_t *reader = Vector_OpenMapped(path.c_str(), VECTOR_MAP_READ_ONLY);
+  ASSERT_NE(reader, nullptr);
+  ASSERT_EQ(Vector_Length(reader), 0);
+  Vector_Destroy(&reader);
+  Vector_Destroy(&v);
+
+  v = Vector_OpenMapped(path.c_str(), VECTOR_MAP_READ_WRITE);
+  ASSERT_EQ(Vector_Length(v), 0);
+  Vector_Destroy(&v);
+
+  FILE *file = fopen(path.c_str(), "wb");
+  fputs("not a vector file at all, just some text", file);
+  fclose(file);
+  ASSERT_EQ(Vector_OpenMapped(path.c_str(), VECTOR_MAP_READ_WRITE), nullptr);
+  ASSERT_FALSE(Vector_SyncMapped(nullptr));
+  remove(path.c_str());
+}
+#endif
+
+TEST(vector, saveAndLoadRoundTrip)
+{
+  FILE *file = tmpfile();
+  ASSERT_NE(file, nullptr);
+  Vector_t *v = Vector_Create(10, 10);
+  std::mt19937_64 random(5);
+  for (int i = 0; i < 10000; i++) {
+    Vector_Append(v, random());
+  }
+  ASSERT_TRUE(Vector_Save(v, file));
+
+  rewind(file);
+  Vector_t *loaded = Vector_Load(file, 10);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_THAT(std::vector<Vector_DataType_t>(loaded->items, loaded->next),
+              ::testing::ElementsAreArray(v->items, Vector_Length(v)));
+  ASSERT_FALSE(Vector_IsSorted(loaded));
+  Vector_Destroy(&loaded);
+
+  // the streaming reader appends the items in chunks
+  rewind(file);
+  Vector_Reader_t reader;
+  ASSERT_TRUE(Vector_ReaderOpen(&reader, file));
+  ASSERT_EQ(reader.length, 10000);
+  loaded = Vector_Create(1, 1);
+  size_t total = 0, count;
+  while ((count = Vector_ReaderRead(&reader, loaded, 3000)) > 0) {
+    ASSERT_NE(count, SIZE_MAX);
+    total += count;
+    ASSERT_EQ(Vector_Length(loaded), total);
+  }
+  ASSERT_EQ(total, 10000);
+  ASSERT_EQ(loaded->items[9999], v->items[9999]);
+  Vector_Destroy(&loaded);
+
+  // a flipped bit is detected by the checksum
+  fseek(file, 16 + 8 * 5000 + 3, SEEK_SET);
+  int byte = fgetc(file);
+  fseek(file, 16 + 8 * 5000 + 3, SEEK_SET);
+  fputc(byte ^ 0x10, file);
+  rewind(file);
+  ASSERT_EQ(Vector_Load(file, 10), nullptr);
+
+  // an empty vector and a wrong header
+  rewind(file);
+  Vector_Clear(v);
+  ASSERT_TRUE(Vector_Save(v, file));
+  rewind(file);
+  loaded = Vector_Load(file, 10);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(Vector_Length(loaded), 0);
+  Vector_Destroy(&loaded);
+  rewind(file);
+  fputs("VECB\x02", file);
+  rewind(file);
+  ASSERT_EQ(Vector_Load(file, 10), nullptr);
+
+  Vector_Destroy(&v);
+  fclose(file);
+}
+
+TEST(compressedVector, matchesSourceAndMergesBlockByBlock)
+{
+  // dense identifiers with duplicates, one huge gap and one block of equal items
+  const size_t length = 10 * COMPRESSED_VECTOR_BLOCK + 17;
+  std::mt19937_64 generator(18);
+  std::vector<Vector_DataType_t> expected;
+  Vector_DataType_t value = 1000;
+  for (size_t i = 0; i < length; i++) {
+    if (i == 3 * COMPRESSED_VECTOR_BLOCK + 5) {
+      value += Vector_DataType_t(1) << 60;
+    } else if (i < 5 * COMPRESSED_VECTOR_BLOCK || i >= 6 * COMPRESSED_VECTOR_BLOCK) {
+      value += generator() % 20;
+    }
+    expected.push_back(value);
+  }
+  Vector_t *v = Vector_Create(length, 10);
+  ASSERT_NE(v, nullptr);
+  ASSERT_EQ(Vector_AppendArray(v, expected.data(), length), 0);
+
+  CompressedVector_t *cv = CompressedVector_Create(v);
+  ASSERT_NE(cv, nullptr);
+  ASSERT_EQ(CompressedVector_Length(cv), length);
+  ASSERT_LT(CompressedVector_MemorySize(cv), length * sizeof(Vector_DataType_t) / 4);
+  for (size_t i = 0; i < length; i++) {
+    Vector_DataType_t item;
+    ASSERT_TRUE(CompressedVector_At(cv, i, &item));
+    ASSERT_EQ(item, expected[i]) << "at " << i;
+  }
+  Vector_DataType_t item;
+  ASSERT_FALSE(CompressedVector_At(cv, length, &item));
+
+  for (size_t i = 0; i < length; i += 7) {
+    for (Vector_DataType_t searched : {expected[i], expected[i] + 1, expected[i] - 1}) {
+      auto found = std::lower_bound(expected.begin(), expected.end(), searched);
+      size_t index = found != expected.end() && *found == searched ? found - expected.begin()
+                                                                   : SIZE_MAX;
+      ASSERT_EQ(CompressedVector_IndexOf(cv, searched), index) << "searched " << searched;
+    }
+  }
+  ASSERT_TRUE(CompressedVector_Contains(cv, expected.back()));
+  ASSERT_FALSE(CompressedVector_Contains(cv, 0));
+  ASSERT_FALSE(CompressedVector_Contains(cv, expected.back() + 1));
+
+  std::vector<Vector_DataType_t> decoded(300);
+  ASSERT_EQ(CompressedVector_Decode(cv, COMPRESSED_VECTOR_BLOCK - 10, decoded.data(), 300), 300);
+  ASSERT_TRUE(std::equal(decoded.begin(),
+                         decoded.end(),
+                         expected.begin() + COMPRESSED_VECTOR_BLOCK - 10));
+  ASSERT_EQ(CompressedVector_Decode(cv, length - 3, decoded.data(), 300), 3);
+
+  // the result equals merging of the decompressed inputs
+  Vector_t *other = Vector_Create(10, 10);
+  for (size_t i = 0; i < 3 * COMPRESSED_VECTOR_BLOCK; i++) {
+    Vector_Append(other, 990 + 3 * i);
+  }
+  CompressedVector_t *otherCompressed = CompressedVector_Create(other);
+  Vector_t *decompressed = Vector_Create(10, 10);
+  ASSERT_TRUE(CompressedVector_Decompress(cv, decompressed));
+  ASSERT_EQ(Vector_Length(decompressed), length);
+  ASSERT_TRUE(decompressed->sorted);
+  Vector_t *merged = Vector_Create(10, 10), *plainMerged = Vector_Create(10, 10);
+  ASSERT_TRUE(CompressedVector_Merge(merged, cv, otherCompressed));
+  Merge(plainMerged, decompressed, other);
+  ASSERT_EQ(Vector_Length(merged), Vector_Length(plainMerged));
+  ASSERT_TRUE(std::equal(merged->items, merged->next, plainMerged->items));
+  ASSERT_TRUE(merged->sorted);
+
+  Vector_Set(v, 0, Vector_DataType_t(-1));
+  ASSERT_EQ(CompressedVector_Create(v), nullptr);  // not sorted any more
+
+  Vector_Destroy(&v);
+  Vector_Destroy(&other);
+  Vector_Destroy(&decompressed);
+  Vector_Destroy(&merged);
+  Vector_Destroy(&plainMerged);
+  CompressedVector_Destroy(&otherCompressed);
+  CompressedVector_Destroy(&cv);
+  ASSERT_EQ(cv, nullptr);
+}
+
+TEST(concurrentVector, producersAppendWhileReaderReadsPublishedItems)
+{
+  const size_t producerCount = 4, perProducer = 3 * CONCURRENT_VECTOR_FIRST_SEGMENT + 11;
+  ConcurrentVector_t *v = ConcurrentVector_Create(100);
+  ASSERT_NE(v, nullptr);
+  ASSERT_EQ(ConcurrentVector_Length(v), 0);
+
+  // each item encodes its producer and its index, odd producers append blocks of items; failures
+  // are only counted by the threads, the reader then stops and the threads are joined to assert
+  std::atomic<size_t> failures(0);
+  std::vector<std::thread> producers;
+  for (size_t t = 0; t < producerCount; t++) {
+    producers.emplace_back([v, t, perProducer, &failures]() {
+      for (size_t i = 0; i < perProducer;) {
+        Vector_DataType_t block[37];
+        size_t count = t % 2 ? std::min<size_t>(37, perProducer - i) : 1;
+        for (size_t j = 0; j < count; j++) {
+          block[j] = (Vector_DataType_t(t) << 32) | (i + j);
+        }
+        if (ConcurrentVector_AppendArray(v, block, count) == SIZE_MAX) {
+          failures++;
+          return;
+        }
+        i += count;
+      }
+    });
+  }
+  size_t lastLength = 0;
+  bool consistent = true;
+  while (consistent && failures.load() == 0 && lastLength < producerCount * perProducer) {
+    size_t length = ConcurrentVector_Length(v);
+    Vector_DataType_t value;
+    consistent = length >= lastLength
+                 && (length == 0
+                     || (ConcurrentVector_At(v, length - 1, &value) && value >> 32 < producerCount
+                         && (value & 0xFFFFFFFF) < perProducer));
+    lastLength = length;
+  }
+  for (std::thread &producer : producers) {
+    producer.join();
+  }
+  ASSERT_EQ(failures.load(), 0);
+  ASSERT_TRUE(consistent);
+
+  Vector_DataType_t value;
+  ASSERT_FALSE(ConcurrentVector_At(v, producerCount * perProducer, &value));
+  ASSERT_EQ(ConcurrentVector_Append(v, 1ull << 40), producerCount * perProducer);
+  Vector_t *snapshot = Vector_Create(10, 10);
+  ASSERT_TRUE(ConcurrentVector_Snapshot(v, snapshot));
+  ASSERT_EQ(Vector_Length(snapshot), producerCount * perProducer + 1);
+  ASSERT_TRUE(Vector_Sort(snapshot));
+  for (size_t t = 0; t < producerCount; t++) {
+    for (size_t i = 0; i < perProducer; i++) {
+      ASSERT_EQ(snapshot->items[t * perProducer + i], (Vector_DataType_t(t) << 32) | i);
+    }
+  }
+
+  Vector_Destroy(&snapshot);
+  ConcurrentVector_Destroy(&v);
+  ASSERT_EQ(v, nullptr);
+  ASSERT_EQ(ConcurrentVector_Length(v), SIZE_MAX);
+}
+
+TEST(vector, snapshotsStayUnchangedWhileWriterPublishes)
+{
+  Vector_t *initial = Vector_Create(10, 10);
+  for (Vector_DataType_t i = 0; i < 1000; i++) {
+    Vector_Append(initial, i);
+  }
+  Vector_Shared_t *shared = Vector_SharedCreate(initial);
+  ASSERT_NE(shared, nullptr);
+
+  Vector_Snapshot_t old;
+  const Vector_t *oldVersion = Vector_Snapshot(shared, &old);
+  ASSERT_EQ(oldVersion, initial);
+  Vector_t *draft = Vector_SharedBeginWrite(shared);
+  ASSERT_NE(draft, nullptr);
+  ASSERT_NE(draft, initial);
+  ASSERT_TRUE(Vector_Remove(draft, 0));
+  Vector_Set(draft, 0, 7);
+  ASSERT_TRUE(Vector_SharedPublish(shared));
+  ASSERT_FALSE(Vector_SharedPublish(shared));  // no write in progress
+
+  // the old snapshot still sees the first version, which is retired but not reclaimed
+  Vector_DataType_t value;
+  ASSERT_EQ(Vector_Length(old.vector), 1000);
+  ASSERT_TRUE(Vector_At(old.vector, 0, &value));
+  ASSERT_EQ(value, 0);
+  Vector_Snapshot_t current;
+  ASSERT_EQ(Vector_Snapshot(shared, &current), draft);
+  ASSERT_EQ(Vector_Length(current.vector), 999);
+  ASSERT_EQ(Vector_IndexOf(current.vector, 7, 0), 0);
+  ASSERT_EQ(Vector_SharedReclaim(shared), 1);
+  Vector_SnapshotRelease(&old);
+  ASSERT_EQ(old.vector, nullptr);
+  ASSERT_EQ(Vector_SharedReclaim(shared), 0);
+  Vector_SnapshotRelease(&current);
+
+  // the reclaimed version is reused by the next write, a cancelled write changes nothing
+  ASSERT_EQ(Vector_SharedBeginWrite(shared), initial);
+  Vector_SharedCancelWrite(shared);
+  ASSERT_EQ(Vector_Snapshot(shared, &current), draft);
+  Vector_SnapshotRelease(&current);
+
+  // readers check that each version is a contiguous run of values while the writer shifts it,
+  // failures are counted and asserted after all threads are joined
+  std::atomic<bool> done(false);
+  std::atomic<size_t> failures(0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; r++) {
+    readers.emplace_back([shared, &done, &failures]() {
+      while (!done.load()) {
+        Vector_Snapshot_t snapshot = {};
+        const Vector_t *version = Vector_Snapshot(shared, &snapshot);
+        bool consistent = version != nullptr && Vector_Length(version) == 999;
+        for (size_t i = 1; consistent && i < 999; i++) {
+          consistent = version->items[i] == version->items[1] + i - 1;
+        }
+        Vector_SnapshotRelease(&snapshot);
+        if (!consistent) {
+          failures++;
+          return;
+        }
+      }
+    });
+  }
+  bool published = true;
+  for (Vector_DataType_t i = 0; published && i < 300; i++) {
+    Vector_t *next = Vector_SharedBeginWrite(shared);
+    published = next != nullptr && Vector_Remove(next, 1)
+                && Vector_Append(next, 1000 + i) != SIZE_MAX && Vector_SharedPublish(shared);
+  }
+  done = true;
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  ASSERT_TRUE(published);
+  ASSERT_EQ(failures.load(), 0);
+  ASSERT_EQ(Vector_SharedReclaim(shared), 0);
+
+  Vector_SharedDestroy(&shared);
+  ASSERT_EQ(shared, nullptr);
+}
+
+TEST(vector, parallelOperationsMatchSerialOnes)
+{
+  const size_t length = 200000;
+  Vector_t *vector = Vector_Create(length, 10);
+  for (size_t i = 0; i < length; i++) {
+    Vector_Append(vector, i);
+  }
+  // the predicate is called from many threads, so it must not share state like isOdd does
+  auto odd = [](Vector_DataType_t value, void *) { return value % 2 == 1; };
+  Vector_t *copy = Vector_ParallelCopy(vector);
+  ASSERT_NE(copy, nullptr);
+  ASSERT_EQ(Vector_Length(copy), length);
+  ASSERT_TRUE(copy->sorted);
+  ASSERT_EQ(memcmp(copy->items, vector->items, length * sizeof(Vector_DataType_t)), 0);
+
+  Vector_DataType_t value;
+  ASSERT_TRUE(Vector_Reduce(vector, VECTOR_REDUCE_SUM, &value));
+  ASSERT_EQ(value, length * (length - 1) / 2);
+  ASSERT_TRUE(Vector_Reduce(vector, VECTOR_REDUCE_MAX, &value));
+  ASSERT_EQ(value, length - 1);
+  ASSERT_EQ(Vector_CountIf(vector, odd, NULL), length / 2);
+
+  // parallel operations called by a predicate run serially instead of waiting for the pool
+  auto sumMatches = [](Vector_DataType_t value, void *context) {
+    const Vector_t *items = static_cast<const Vector_t *>(context);
+    Vector_DataType_t sum = 0;
+    size_t length = Vector_Length(items);
+    return value % 20000 == 0 && Vector_Reduce(items, VECTOR_REDUCE_SUM, &sum)
+           && sum == length * (length - 1) / 2;
+  };
+  ASSERT_EQ(Vector_CountIf(vector, sumMatches, vector), length / 20000);
+
+  // a misaligned range crossing many chunks, the items around it stay untouched
+  Vector_ParallelFill(copy, 1, 3, length - 4);
+  ASSERT_FALSE(copy->sorted);
+  ASSERT_TRUE(Vector_At(copy, 2, &value));
+  ASSERT_EQ(value, 2);
+  ASSERT_TRUE(Vector_At(copy, length - 3, &value));
+  ASSERT_EQ(value, length - 3);
+  ASSERT_EQ(Vector_CountIf(copy, odd, NULL), length - 3);
+  ASSERT_TRUE(Vector_Reduce(copy, VECTOR_REDUCE_MIN, &value));
+  ASSERT_EQ(value, 0);
+  Vector_ParallelFill(copy, 1, 0, SIZE_MAX);
+  ASSERT_TRUE(Vector_Reduce(copy, VECTOR_REDUCE_SUM, &value));
+  ASSERT_EQ(value, length);
+
+  Vector_Clear(vector);
+  ASSERT_TRUE(Vector_Reduce(vector, VECTOR_REDUCE_SUM, &value));
+  ASSERT_EQ(value, 0);
+  ASSERT_FALSE(Vector_Reduce(vector, VECTOR_REDUCE_MIN, &value));
+  ASSERT_EQ(Vector_CountIf(vector, odd, NULL), 0);
+
+  Vector_Destroy(&vector);
+  Vector_Destroy(&copy);
+}
+
+TEST(typedVector, storesNaturalWidthAndSortsByValue)
+{
+  // radix sort of 32-bit items, the search switches to binary search once the vector is sorted
+  std::mt19937 generator(22);
+  std::vector<uint32_t> ids(1000);
+  for (uint32_t &id : ids) {
+    id = generator();
+  }
+  VectorU32_t *u32 = VectorU32_Create(0, 0);
+  ASSERT_EQ(VectorU32_AppendArray(u32, ids.data(), ids.size()), 0);
+  ASSERT_EQ(VectorU32_Append(u32, ids[10]), ids.size());
+  ASSERT_FALSE(u32->sorted);
+  ASSERT_EQ(VectorU32_IndexOf(u32, ids[10], 0), 10);
+  ASSERT_EQ(VectorU32_IndexOf(u32, ids[10], 11), ids.size());
+  ASSERT_EQ(VectorU32_CountOf(u32, ids[10]), 2);
+  ASSERT_TRUE(VectorU32_Sort(u32));
+  ids.push_back(ids[10]);
+  std::sort(ids.begin(), ids.end());
+  ASSERT_THAT(std::vector<uint32_t>(u32->items, u32->next), ::testing::ElementsAreArray(ids));
+  ASSERT_TRUE(VectorU32_Contains(u32, ids[500]));
+  ASSERT_TRUE(VectorU32_Remove(u32, 500));
+  ASSERT_TRUE(u32->sorted);
+  VectorU32_Set(u32, 0, UINT32_MAX);
+  ASSERT_FALSE(u32->sorted);
+  VectorU32_Destroy(&u32);
+  ASSERT_EQ(u32, nullptr);
+
+  // negative items precede the positive ones, both by heap sort and by radix sort
+  for (size_t length : {50, 500}) {
+    VectorI16_t *i16 = VectorI16_Create(length, 0);
+    for (size_t i = 0; i < length; i++) {
+      VectorI16_Append(i16, static_cast<int16_t>((i % 2 ? -1 : 1) * static_cast<int>(i * 61)));
+    }
+    ASSERT_EQ(i16->size, length);
+    std::vector<int16_t> samples(i16->items, i16->next);
+    std::sort(samples.begin(), samples.end());
+    ASSERT_TRUE(VectorI16_Sort(i16));
+    ASSERT_THAT(std::vector<int16_t>(i16->items, i16->next), ::testing::ElementsAreArray(samples));
+    int16_t value;
+    ASSERT_TRUE(VectorI16_At(i16, 0, &value));
+    ASSERT_EQ(value, samples[0]);
+    ASSERT_EQ(VectorI16_IndexOf(i16, samples[length / 2], 0), length / 2);
+    VectorI16_Fill(i16, 7, 0, SIZE_MAX);
+    ASSERT_TRUE(i16->sorted);
+    ASSERT_EQ(VectorI16_CountOf(i16, 7), length);
+    VectorI16_Destroy(&i16);
+  }
+
+  VectorF64_t *f64 = VectorF64_Create(4, 0);
+  double values[] = {2.5, -1.0, 0.0, -1e300, 1e-300, -0.0, 3.0};
+  ASSERT_EQ(VectorF64_AppendArray(f64, values, 7), 0);
+  ASSERT_TRUE(VectorF64_Contains(f64, 1e-300));
+  ASSERT_TRUE(VectorF64_Sort(f64));
+  ASSERT_THAT(std::vector<double>(f64->items, f64->next),
+              ::testing::ElementsAre(-1e300, -1.0, -0.0, 0.0, 1e-300, 2.5, 3.0));
+  ASSERT_TRUE(std::signbit(f64->items[2]));
+  ASSERT_EQ(VectorF64_IndexOf(f64, 2.5, 0), 5);
+  ASSERT_FALSE(VectorF64_Contains(f64, 2.0));
+  VectorF64_Clear(f64);
+  ASSERT_EQ(VectorF64_Length(f64), 0);
+  ASSERT_EQ(VectorF64_Length(nullptr), SIZE_MAX);
+  VectorF64_Destroy(&f64);
+}
+
+TEST(typedVector, floatSearchesUseEqualityWhetherSortedOrNot)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  double values[] = {1.0, 0.0, nan, -0.0, 2.0};
+  VectorF64_t *f64 = VectorF64_Create(0, 0);
+  ASSERT_EQ(VectorF64_AppendArray(f64, values, 5), 0);
+  ASSERT_FALSE(f64->sorted);
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (double zero : {0.0, -0.0}) {
+      ASSERT_TRUE(VectorF64_Contains(f64, zero));
+      ASSERT_EQ(VectorF64_CountOf(f64, zero), 2);
+      size_t first = VectorF64_IndexOf(f64, zero, 0);
+      ASSERT_EQ(f64->items[first], 0.0);
+      size_t second = VectorF64_IndexOf(f64, zero, first + 1);
+      ASSERT_NE(second, SIZE_MAX);
+      ASSERT_EQ(f64->items[second], 0.0);
+      ASSERT_EQ(VectorF64_IndexOf(f64, zero, second + 1), SIZE_MAX);
+    }
+    ASSERT_FALSE(VectorF64_Contains(f64, nan));
+    ASSERT_EQ(VectorF64_CountOf(f64, nan), 0);
+    ASSERT_EQ(VectorF64_IndexOf(f64, 2.0, 0), pass == 0 ? 4 : 3);
+
+    // the sorted vector is searched by binary search over -0.0, 0.0, 1.0, 2.0, NaN
+    ASSERT_TRUE(VectorF64_Sort(f64));
+    ASSERT_TRUE(std::signbit(f64->items[0]));
+    ASSERT_TRUE(std::isnan(f64->items[4]));
+  }
+  VectorF64_Destroy(&f64);
+}
+
+TEST(typedVector, copiesMergesAndGrowsByAllocStep)
+{
+  Vector_CountingAllocator_t counting;
+  Vector_CountingAllocatorInit(&counting, nullptr);
+  VectorU32_t *odd = VectorU32_CreateWithAllocator(0, 3, &counting.allocator);
+  for (uint32_t value : {1, 3, 5, 7}) {
+    VectorU32_Append(odd, value);
+  }
+  ASSERT_EQ(odd->size, 6);
+  ASSERT_EQ(counting.stats.reallocations + counting.stats.allocations, 3);
+
+  VectorU32_t *copy = VectorU32_Copy(odd);
+  ASSERT_NE(copy, nullptr);
+  ASSERT_NE(copy->items, odd->items);
+  ASSERT_EQ(copy->allocator, &counting.allocator);
+  ASSERT_EQ(copy->alloc_step, 3);
+  ASSERT_TRUE(copy->sorted);
+  ASSERT_THAT(std::vector<uint32_t>(copy->items, copy->next), ::testing::ElementsAre(1, 3, 5, 7));
+  ASSERT_EQ(VectorU32_Copy(nullptr), nullptr);
+
+  uint32_t even[] = {0, 2, 3, 8};
+  VectorU32_t *result = VectorU32_Create(0, 0);
+  VectorU32_Append(result, 0);
+  VectorU32_t *evens = VectorU32_Create(0, 0);
+  VectorU32_AppendArray(evens, even, 4);
+  ASSERT_TRUE(VectorU32_Merge(result, odd, evens));
+  ASSERT_TRUE(result->sorted);
+  ASSERT_THAT(std::vector<uint32_t>(result->items, result->next),
+              ::testing::ElementsAre(0, 0, 1, 2, 3, 3, 5, 7, 8));
+
+  // the result may be one of the inputs, the merged items are appended behind its own
+  ASSERT_TRUE(VectorU32_Merge(copy, copy, evens));
+  ASSERT_FALSE(copy->sorted);
+  ASSERT_THAT(std::vector<uint32_t>(copy->items, copy->next),
+              ::testing::ElementsAre(1, 3, 5, 7, 0, 1, 2, 3, 3, 5, 7, 8));
+
+  // unsorted inputs are rejected and the result is not modified
+  ASSERT_FALSE(VectorU32_Merge(result, copy, evens));
+  ASSERT_FALSE(VectorU32_Merge(result, nullptr, evens));
+  ASSERT_EQ(VectorU32_Length(result), 9);
+
+  VectorU32_Destroy(&odd);
+  VectorU32_Destroy(&copy);
+  VectorU32_Destroy(&result);
+  VectorU32_Destroy(&evens);
+  ASSERT_EQ(counting.stats.live_bytes, 0);
+}
+
+TEST(columnarVector, rowsStayAlignedAcrossColumns)
+{
+  Vector_CountingAllocator_t counting;
+  Vector_CountingAllocatorInit(&counting, nullptr);
+  ColumnarVector_t *table = ColumnarVector_CreateWithAllocator(3, 2, &counting.allocator);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(ColumnarVector_Create(0, 10), nullptr);
+  Vector_Allocator_t noAlloc = counting.allocator;
+  noAlloc.alloc = nullptr;
+  ASSERT_EQ(ColumnarVector_CreateWithAllocator(3, 2, &noAlloc), nullptr);
+  ASSERT_EQ(table->size, COLUMNAR_VECTOR_ROW_ALIGN);
+
+  // all columns grow by one reallocation, the rows already stored move with their columns
+  for (Vector_DataType_t i = 0; i < 1000; i++) {
+    Vector_DataType_t row[] = {i, 2 * i, i % 7};
+    ASSERT_EQ(ColumnarVector_AppendRow(table, row), i);
+  }
+  ASSERT_EQ(counting.stats.reallocations, 7);
+  ASSERT_EQ(table->size % COLUMNAR_VECTOR_ROW_ALIGN, 0);
+  const Vector_DataType_t *doubled = ColumnarVector_Column(table, 1);
+  for (size_t i = 0; i < 1000; i++) {
+    ASSERT_EQ(doubled[i], 2 * i);
+  }
+  ASSERT_EQ(ColumnarVector_Column(table, 3), nullptr);
+
+  Vector_DataType_t ids[] = {5000, 5001};
+  Vector_DataType_t twice[] = {10000, 10002};
+  Vector_DataType_t mod[] = {9, 9};
+  const Vector_DataType_t *columns[] = {ids, twice, mod};
+  ASSERT_EQ(ColumnarVector_AppendColumns(table, columns, 2), 1000);
+  ASSERT_EQ(ColumnarVector_Length(table), 1002);
+  ASSERT_EQ(ColumnarVector_IndexOf(table, 2, 9, 0), 1000);
+  ASSERT_EQ(ColumnarVector_IndexOf(table, 2, 3, 4), 10);
+  ASSERT_EQ(ColumnarVector_IndexOf(table, 2, 8, 0), SIZE_MAX);
+
+  Vector_DataType_t row[3];
+  ASSERT_TRUE(ColumnarVector_RemoveRow(table, 0));
+  ASSERT_TRUE(ColumnarVector_GetRow(table, 0, row));
+  ASSERT_THAT(row, ::testing::ElementsAre(1, 2, 1));
+  ASSERT_TRUE(ColumnarVector_SwapRemoveRow(table, 0));
+  ASSERT_TRUE(ColumnarVector_GetRow(table, 0, row));
+  ASSERT_THAT(row, ::testing::ElementsAre(5001, 10002, 9));
+  ColumnarVector_Set(table, 0, 2, 4);
+  Vector_DataType_t value;
+  ASSERT_TRUE(ColumnarVector_At(table, 0, 2, &value));
+  ASSERT_EQ(value, 4);
+  ASSERT_FALSE(ColumnarVector_At(table, 1000, 0, &value));
+  ASSERT_FALSE(ColumnarVector_GetRow(table, 1000, row));
+  ASSERT_EQ(ColumnarVector_Length(table), 1000);
+
+  ColumnarVector_Destroy(&table);
+  ASSERT_EQ(table, nullptr);
+  ASSERT_EQ(counting.stats.live_bytes, 0);
+}
+
+TEST(vector, spansReadAndMergeSlicesWithoutCopying)
+{
+  Vector_t *v = Vector_Create(10, 10);
+  for (Vector_DataType_t i = 0; i < 100; i++) {
+    Vector_Append(v, 3 * i);
+  }
+  Vector_Span_t all = Vector_GetSpan(v);
+  ASSERT_EQ(all.data, v->items);
+  ASSERT_EQ(all.length, 100);
+  ASSERT_TRUE(all.sorted);
+
+  Vector_Span_t middle = Vector_SpanSlice(all, 10, 20);
+  ASSERT_EQ(middle.data, v->items + 10);
+  ASSERT_EQ(middle.length, 20);
+  ASSERT_EQ(Vector_SpanIndexOf(middle, 36, 0), 2);
+  ASSERT_EQ(Vector_SpanIndexOf(middle, 36, 3), SIZE_MAX);
+  ASSERT_FALSE(Vector_SpanContains(middle, 0));
+  ASSERT_FALSE(Vector_SpanContains(middle, 37));
+  ASSERT_EQ(Vector_SpanSlice(all, 95, 20).length, 5);
+  ASSERT_EQ(Vector_SpanSlice(all, 100, 1).length, 0);
+  ASSERT_EQ(Vector_GetSpan(nullptr).length, 0);
+  ASSERT_FALSE(Vector_SpanContains(Vector_GetSpan(nullptr), 0));
+
+  // unsorted spans are searched linearly
+  Vector_Set(v, 0, 1000);
+  Vector_Span_t unsorted = Vector_GetSpan(v);
+  ASSERT_FALSE(unsorted.sorted);
+  ASSERT_EQ(Vector_SpanIndexOf(unsorted, 1000, 0), 0);
+  ASSERT_EQ(Vector_SpanIndexOf(unsorted, 6, 0), 2);
+
+  Vector_t *merged = Vector_Create(0, 10);
+  ASSERT_TRUE(Vector_SpanMerge(merged, Vector_SpanSlice(unsorted, 1, 3), middle));
+  ASSERT_THAT(std::vector<Vector_DataType_t>(merged->items, merged->next),
+              ::testing::ElementsAreArray({3, 6, 9, 30, 33, 36, 39, 42, 45, 48, 51, 54, 57, 60, 63,
+                                           66, 69, 72, 75, 78, 81, 84, 87}));
+  ASSERT_TRUE(merged->sorted);
+  ASSERT_FALSE(Vector_SpanMerge(nullptr, middle, middle));
+
+  Vector_Destroy(&merged);
+  Vector_Destroy(&v);
+}
+
+TEST(vector, hashIndexTracksAppendsAndRebuildsAfterWrites)
+{
+  Vector_CountingAllocator_t counting;
+  Vector_CountingAllocatorInit(&counting, nullptr);
+  Vector_Growth_t growth = {VECTOR_GROWTH_GEOMETRIC, 16, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+  Vector_t *v = Vector_CreateWithAllocator(16, &growth, &counting.allocator);
+  ASSERT_NE(v, nullptr);
+  ASSERT_FALSE(Vector_BuildIndex(nullptr, false));
+  ASSERT_EQ(Vector_IndexMemorySize(v), 0);
+  ASSERT_TRUE(Vector_BuildIndex(v, false));
+  ASSERT_GT(Vector_IndexMemorySize(v), 0);
+
+  // appends are indexed as they come, values repeat so the first occurrence must be kept
+  for (Vector_DataType_t i = 0; i < 10000; i++) {
+    Vector_Append(v, (i * 7919) % 5000);
+  }
+  ASSERT_FALSE(Vector_IsSorted(v));
+  ASSERT_LT(Vector_IndexMemorySize(v), 10000 * sizeof(Vector_DataType_t) * 5);
+  for (Vector_DataType_t value = 0; value < 5000; value++) {
+    size_t first = Vector_IndexOf(v, value, 0);
+    ASSERT_EQ(first, std::find(v->items, v->next, value) - v->items);
+    ASSERT_EQ(Vector_IndexOf(v, value, first + 1), first + 5000);
+    ASSERT_TRUE(Vector_Contains(v, value));
+  }
+  ASSERT_FALSE(Vector_Contains(v, 5000));
+  ASSERT_EQ(Vector_IndexOf(v, 5000, 0), SIZE_MAX);
+
+  // other writes make the next lookup rebuild the index
+  Vector_Set(v, 0, 123456);
+  ASSERT_TRUE(Vector_Contains(v, 123456));
+  ASSERT_EQ(Vector_IndexOf(v, 0, 0), 5000);
+  ASSERT_TRUE(Vector_Remove(v, 0));
+  ASSERT_FALSE(Vector_Contains(v, 123456));
+  ASSERT_EQ(Vector_IndexOf(v, 0, 0), 4999);
+  Vector_Fill(v, 42, 0, 8000);
+  ASSERT_EQ(Vector_IndexOf(v, 42, 0), 0);
+  ASSERT_FALSE(Vector_Contains(v, 0));
+  ASSERT_TRUE(Vector_Sort(v));
+  ASSERT_EQ(Vector_IndexOf(v, 42, 0), std::count_if(v->items, v->next, [](Vector_DataType_t x) {
+              return x < 42;
+            }));
+  Vector_Clear(v);
+  ASSERT_FALSE(Vector_Contains(v, 42));
+  Vector_Append(v, 7);
+  ASSERT_TRUE(Vector_Contains(v, 7));
+
+  Vector_DropIndex(v);
+  ASSERT_EQ(Vector_IndexMemorySize(v), 0);
+  ASSERT_TRUE(Vector_Contains(v, 7));
+
+  // a lazy index is built by the next write, lookups search the items until then
+  Vector_t *lazy = Vector_Create(10, 10);
+  for (Vector_DataType_t i = 0; i < 100; i++) {
+    Vector_Append(lazy, 100 - i);
+  }
+  ASSERT_TRUE(Vector_BuildIndex(lazy, true));
+  size_t lazySize = Vector_IndexMemorySize(lazy);
+  ASSERT_EQ(Vector_IndexOf(lazy, 1, 0), 99);
+  ASSERT_EQ(Vector_IndexOf(lazy, 100, 1), SIZE_MAX);
+  ASSERT_EQ(Vector_IndexMemorySize(lazy), lazySize);
+  Vector_Append(lazy, 0);
+  ASSERT_GT(Vector_IndexMemorySize(lazy), lazySize);
+  ASSERT_EQ(Vector_IndexOf(lazy, 0, 0), 100);
+  Vector_Destroy(&lazy);
+
+  ASSERT_TRUE(Vector_BuildIndex(v, true));
+  Vector_Destroy(&v);
+  ASSERT_EQ(counting.stats.live_bytes, 0);
+}
+
+TEST(vector, everySupportedKernelMatchesStdAlgorithms)
+{
+  size_t tables = 0;
+  while (vector_kernels_supported(tables) != nullptr) {
+    tables++;
+  }
+  ASSERT_GE(tables, 1);
+  ASSERT_EQ(vector_kernels_supported(tables - 1), vector_kernels_get());
+
+  // every length up to a few SIMD blocks with the match at every position covers all tails
+  std::vector<Vector_DataType_t> items;
+  for (size_t t = 0; t < tables; t++) {
+    const VectorKernels_t *kernels = vector_kernels_supported(t);
+    for (size_t count = 0; count < 40; count++) {
+      items.assign(count, 1);
+      ASSERT_EQ(kernels->find_first(items.data(), count, 2), count) << "kernels " << t;
+      ASSERT_EQ(kernels->find_last(items.data(), count, 2), count) << "kernels " << t;
+      ASSERT_EQ(kernels->count(items.data(), count, 1), count) << "kernels " << t;
+      for (size_t i = 0; i < count; i++) {
+        items.assign(count, 1);
+        items[i] = 2;
+        items[count - 1 - (count - 1 - i) / 2] = 2;
+        size_t last = count - 1 - (count - 1 - i) / 2;
+        ASSERT_EQ(kernels->find_first(items.data(), count, 2), i) << "kernels " << t;
+        ASSERT_EQ(kernels->find_last(items.data(), count, 2), last) << "kernels " << t;
+        ASSERT_EQ(kernels->count(items.data(), count, 2), i == last ? 1 : 2) << "kernels " << t;
+      }
+    }
+  }
+}
+
+TEST(vector, loadChecksLengthAgainstStream)
+{
+  Vector_t *v = Vector_Create(10, 10);
+  for (Vector_DataType_t i = 0; i < 100000; i++) {
+    Vector_Append(v, i * i);
+  }
+  FILE *file = tmpfile();
+  ASSERT_NE(file, nullptr);
+  ASSERT_TRUE(Vector_Save(v, file));
+  std::vector<unsigned char> bytes(ftell(file));
+  rewind(file);
+  ASSERT_EQ(fread(bytes.data(), 1, bytes.size(), file), bytes.size());
+
+  // a reader can be asked for nothing, which is not the same as being finished
+  rewind(file);
+  Vector_Reader_t reader;
+  ASSERT_TRUE(Vector_ReaderOpen(&reader, file));
+  Vector_t *loaded = Vector_Create(1, 1);
+  ASSERT_EQ(Vector_ReaderRead(&reader, loaded, 0), SIZE_MAX);
+  ASSERT_FALSE(Vector_ReaderFinished(&reader));
+  ASSERT_EQ(Vector_ReaderRead(&reader, loaded, 200000), 100000);
+  ASSERT_TRUE(Vector_ReaderFinished(&reader));
+  ASSERT_EQ(Vector_ReaderRead(&reader, loaded, 0), 0);
+  Vector_Destroy(&loaded);
+
+  // lengths the file cannot hold are rejected before anything is allocated for them
+  for (uint64_t length : {uint64_t(1) << 60, uint64_t(100001), UINT64_MAX}) {
+    fseek(file, 8, SEEK_SET);
+    for (int i = 0; i < 8; i++) {
+      fputc((int)(length >> (8 * i)) & 0xFF, file);
+    }
+    rewind(file);
+    ASSERT_FALSE(Vector_ReaderOpen(&reader, file));
+    rewind(file);
+    ASSERT_EQ(Vector_Load(file, 10), nullptr);
+  }
+  fclose(file);
+
+  // a pipe has no size, it is read in chunks and a wrong length only makes the load fail
+  for (bool corrupt : {false, true}) {
+    if (corrupt) {
+      bytes[8 + 6] = 0x10;
+    }
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ssize_t written = 0;
+    std::thread writer([&] {
+      written = write(fds[1], bytes.data(), bytes.size());
+      close(fds[1]);
+    });
+    FILE *stream = fdopen(fds[0], "rb");
+    loaded = Vector_Load(stream, 10);
+    fclose(stream);
+    writer.join();
+    ASSERT_EQ(written, (ssize_t)bytes.size());
+    if (corrupt) {
+      ASSERT_EQ(loaded, nullptr);
+    } else {
+      ASSERT_NE(loaded, nullptr);
+      ASSERT_THAT(std::vector<Vector_DataType_t>(loaded->items, loaded->next),
+                  ::testing::ElementsAreArray(v->items, Vector_Length(v)));
+      Vector_Destroy(&loaded);
+    }
+  }
+  Vector_Destroy(&v);
+}
+
+TEST(vector, hashIndexIsUpdatedInPlaceBySetAndSwapRemove)
+{
+  Vector_CountingAllocator_t counting;
+  Vector_CountingAllocatorInit(&counting, nullptr);
+  Vector_Growth_t growth = {VECTOR_GROWTH_GEOMETRIC, 16, VECTOR_GROWTH_DEFAULT_FACTOR, 0};
+  Vector_t *v = Vector_CreateWithAllocator(4096, &growth, &counting.allocator);
+  std::vector<Vector_DataType_t> reference;
+  std::mt19937_64 random(25);
+  for (int i = 0; i < 2000; i++) {
+    reference.push_back(random() % 500);
+    Vector_Append(v, reference.back());
+  }
+  ASSERT_TRUE(Vector_BuildIndex(v, false));
+
+  // single item writes never reallocate the table, lookups agree with a linear search
+  size_t allocations = counting.stats.allocations;
+  for (int i = 0; i < 5000; i++) {
+    size_t position = random() % reference.size();
+    if (i % 10 == 0) {
+      ASSERT_TRUE(Vector_SwapRemove(v, position));
+      reference[position] = reference.back();
+      reference.pop_back();
+    } else {
+      reference[position] = random() % 600;
+      Vector_Set(v, position, reference[position]);
+    }
+    Vector_DataType_t value = random() % 600;
+    size_t expected = std::find(reference.begin(), reference.end(), value) - reference.begin();
+    ASSERT_EQ(Vector_IndexOf(v, value, 0), expected == reference.size() ? SIZE_MAX : expected);
+  }
+
+  // removals rebuild the index in the table it already has
+  for (int i = 0; i < 50; i++) {
+    size_t position = random() % reference.size();
+    ASSERT_TRUE(Vector_Remove(v, position));
+    reference.erase(reference.begin() + position);
+    Vector_DataType_t value = random() % 600;
+    size_t expected = std::find(reference.begin(), reference.end(), value) - reference.begin();
+    ASSERT_EQ(Vector_IndexOf(v, value, 0), expected == reference.size() ? SIZE_MAX : expected);
+  }
+  ASSERT_TRUE(Vector_Resize(v, 100, 0));
+  reference.resize(100);
+  for (Vector_DataType_t value = 0; value < 600; value++) {
+    size_t expected = std::find(reference.begin(), reference.end(), value) - reference.begin();
+    ASSERT_EQ(Vector_IndexOf(v, value, 0), expected == reference.size() ? SIZE_MAX : expected);
+  }
+  ASSERT_EQ(counting.stats.allocations, allocations);
+
+  Vector_Destroy(&v);
+  ASSERT_EQ(counting.stats.live_bytes, 0);
+}
+
+TEST(vector, indexedSnapshotsAreSearchedWithoutWrites)
+{
+  Vector_t *initial = Vector_Create(10, 10);
+  for (Vector_DataType_t i = 0; i < 5000; i++) {
+    Vector_Append(initial, 5000 - i);
+  }
+  Vector_Shared_t *shared = Vector_SharedCreate(initial);
+  ASSERT_NE(shared, nullptr);
+  Vector_t *draft = Vector_SharedBeginWrite(shared);
+  ASSERT_TRUE(Vector_BuildIndex(draft, true));
+  Vector_Set(draft, 0, 0);
+  ASSERT_TRUE(Vector_SharedPublish(shared));
+  ASSERT_GT(Vector_IndexMemorySize(draft), 0);
+
+  // readers only look the index up, a stale one would be searched linearly instead of rebuilt
+  std::atomic<size_t> failures(0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; r++) {
+    readers.emplace_back([shared, &failures]() {
+      for (Vector_DataType_t value = 0; value < 5000; value++) {
+        Vector_Snapshot_t snapshot = {};
+        const Vector_t *version = Vector_Snapshot(shared, &snapshot);
+        if (version == nullptr || !Vector_Contains(version, value)
+            || Vector_IndexOf(version, value, 0) != (value == 0 ? 0 : 5000 - value)) {
+          failures++;
+        }
+        Vector_SnapshotRelease(&snapshot);
+      }
+    });
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(failures.load(), 0);
+
+  Vector_SharedDestroy(&shared);
+}
+
 /* Private function definitions ------------------------------------------------------------------*/
\ No newline at end of file